@@ -13,16 +13,32 @@ SOURCES += \
     customlistview.cpp \
     customimagelistview.cpp \
     verify_resources.cpp \
-    texturemanager.cpp \
-    texturebuffer.cpp
+    texturecache.cpp \
+    imagelistnodes.cpp \
+    textureatlas.cpp \
+    titletexturecache.cpp \
+    glyphatlas.cpp \
+    imagedecoder.cpp \
+    thumbnailcache.cpp \
+    imagememorycache.cpp \
+    imageloadscheduler.cpp \
+    imagefetcher.cpp
 
 HEADERS += \
     customrectangle.h \
     customlistview.h \
     customimagelistview.h \
     verify_resources.h \
-    texturemanager.h \
-    texturebuffer.h
+    texturecache.h \
+    imagelistnodes.h \
+    textureatlas.h \
+    titletexturecache.h \
+    glyphatlas.h \
+    imagedecoder.h \
+    thumbnailcache.h \
+    imagememorycache.h \
+    imageloadscheduler.h \
+    imagefetcher.h
 
 # Resources
 RESOURCES += \
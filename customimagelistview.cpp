@@ -17,8 +17,8 @@
 #include <QTimer>
 #include <QSGFlatColorMaterial>
 #include <cmath>
+#include <algorithm>
 #include <QtMath>
-#include "texturemanager.h"
 #include <QGuiApplication>
 #include <QOpenGLContext>
 #include <QSurfaceFormat>
@@ -39,6 +39,9 @@
 CustomImageListView::CustomImageListView(QQuickItem *parent)
     : QQuickItem(parent)
     , m_networkManager(new QNetworkAccessManager(this))
+    , m_titleCache(new TitleTextureCache)
+    , m_glyphAtlas(new GlyphAtlas)
+    , m_thumbnailCache(new ThumbnailCache)
 {
     // Set up rendering flags
     setFlag(ItemHasContents, true);
@@ -55,9 +58,31 @@ CustomImageListView::CustomImageListView(QQuickItem *parent)
     // Configure network manager
     setupNetworkManager();
     
+    // Decode local files and downloaded bytes on worker threads; only texture
+    // creation stays here, a bounded batch at a time
+    m_imageDecoder = new ImageDecoder(this);
+    m_imageDecoder->setThumbnailCache(m_thumbnailCache);
+    
+    // Remote posters go through the fetcher's connection limits and retries
+    m_imageFetcher = new ImageFetcher(m_networkManager, this);
+    connect(m_imageFetcher, SIGNAL(fetched(int,QByteArray,QUrl)),
+            this, SLOT(onImageFetched(int,QByteArray,QUrl)));
+    connect(m_imageFetcher, SIGNAL(fetchFailed(int,QString)),
+            this, SLOT(onImageFetchFailed(int,QString)));
+    
+    // One queue for all poster loads, ordered by distance from the viewport
+    m_loadScheduler = new ImageLoadScheduler(this);
+    connect(m_loadScheduler, SIGNAL(loadRequested(int)), this, SLOT(onLoadRequested(int)));
+    connect(m_loadScheduler, SIGNAL(loadCancelled(int)), this, SLOT(onLoadCancelled(int)));
+    connect(m_imageDecoder, SIGNAL(imagesDecoded(QVector<ImageDecoder::Result>)),
+            this, SLOT(onImagesDecoded(QVector<ImageDecoder::Result>)));
+    
     // Connect to window change signal with proper lambda capture
     connect(this, &QQuickItem::windowChanged, this, [this](QQuickWindow *w) {
         if (w) {
+            // Finished images are uploaded a frame's budget at a time
+            connect(w, SIGNAL(afterAnimating()), this, SLOT(drainUploadQueue()));
+            
             // Capture the window pointer in the inner lambda
             connect(w, &QQuickWindow::beforeRendering, this, [this, w]() {
                 if (!m_windowReady && w->isSceneGraphInitialized()) {
@@ -83,6 +108,7 @@ CustomImageListView::~CustomImageListView()
         // Disconnect signals in Qt 5.6 compatible way
         disconnect(win, SIGNAL(beforeRendering()), this, nullptr);
         disconnect(win, SIGNAL(afterRendering()), this, nullptr);
+        disconnect(win, SIGNAL(afterAnimating()), this, nullptr);
         
         // Block scene graph updates for our item
         setVisible(false);
@@ -97,6 +123,15 @@ CustomImageListView::~CustomImageListView()
     
     // Safe cleanup with proper barriers
     safeCleanup();
+    
+    delete m_glyphAtlas;
+    m_glyphAtlas = nullptr;
+
+    // Workers may still be writing thumbnails; the decoder waits for them
+    delete m_imageDecoder;
+    m_imageDecoder = nullptr;
+    delete m_thumbnailCache;
+    m_thumbnailCache = nullptr;
 }
 
 void CustomImageListView::componentComplete()
@@ -119,6 +154,11 @@ void CustomImageListView::componentComplete()
 void CustomImageListView::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
 {
     QQuickItem::geometryChanged(newGeometry, oldGeometry);
+    
+    // Viewport size drives row and column culling
+    if (newGeometry.size() != oldGeometry.size()) {
+        invalidateLayout();
+    }
 
     // Only reload when we have valid dimensions and window
     if (newGeometry.width() > 0 && newGeometry.height() > 0 && window()) {
@@ -162,37 +202,210 @@ void CustomImageListView::loadAllImages()
     setImplicitHeight(currentY);
     m_count = totalItems;
     
-    // Get list of visible indices first
-    QVector<int> visibleIndices = getVisibleIndices();
-    QVector<int> offscreenIndices;
+    // Queue everything near the viewport, nearest and focused first; the
+    // scheduler starts the loads as slots free up
+    updateLoadPriorities();
+    
+    qDebug() << "Queued" << m_loadScheduler->queuedIndices().size() << "images,"
+             << m_loadScheduler->activeIndices().size() << "loading";
+}
+
+// Row positions in view coordinates, laid out as in updateAllRows
+QVector<qreal> CustomImageListView::rowPositions() const
+{
+    QVector<qreal> rowY(m_rowTitles.size());
+    qreal currentY = -m_contentY;
+    for (int categoryIndex = 0; categoryIndex < m_rowTitles.size(); ++categoryIndex) {
+        CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[categoryIndex]);
+        rowY[categoryIndex] = currentY;
+        currentY += m_titleHeight + 10 + dims.rowHeight + m_rowSpacing;
+    }
+    return rowY;
+}
+
+// Queues every poster within one screen of the viewport that has no texture
+// yet, ordered by its distance from the viewport and then from the focused
+// poster. Posters further out are withdrawn, including loads in flight.
+void CustomImageListView::updateLoadPriorities()
+{
+    m_loadPriorityUpdateScheduled = false;
+    
+    if (m_isBeingDestroyed || !isReadyForTextures() || width() <= 0 || height() <= 0) {
+        return;
+    }
+    
+    const QRectF viewport(0, 0, width(), height());
+    const QRectF loadWindow = viewport.adjusted(-width(), -height(), width(), height());
+    const QHash<int, qreal> prefetch = prefetchPriorities();
+    
+    const QVector<qreal> rowY = rowPositions();
     
-    // Add all other indices to the offscreen list
-    for (int i = 0; i < m_count; i++) {
-        if (!visibleIndices.contains(i)) {
-            offscreenIndices.append(i);
+    QPointF focusCenter = viewport.center();
+    int focusCategory = m_itemCategories.value(m_currentIndex, -1);
+    if (focusCategory >= 0 && focusCategory < m_rowTitles.size()) {
+        focusCenter = posterRect(focusCategory, m_itemColumns.value(m_currentIndex))
+                .translated(-getCategoryContentX(m_rowTitles[focusCategory]), rowY[focusCategory])
+                .center();
+    }
+    
+    for (int categoryIndex = 0; categoryIndex < m_rowTitles.size(); ++categoryIndex) {
+        const QVector<int> &indices = m_rowItemIndices.value(categoryIndex);
+        qreal contentX = getCategoryContentX(m_rowTitles[categoryIndex]);
+        
+        for (int column = 0; column < indices.size(); ++column) {
+            int index = indices[column];
+            if ((m_nodes.contains(index) && m_nodes[index].texture) || m_waitingPosterKeys.contains(index)
+                    || m_queuedUploadKeys.contains(index)) {
+                continue;
+            }
+            
+            QRectF rect = posterRect(categoryIndex, column).translated(-contentX, rowY[categoryIndex]);
+            auto prefetchIt = prefetch.constFind(index);
+            if (prefetchIt != prefetch.constEnd()) {
+                m_loadScheduler->schedule(index, prefetchIt.value());
+                continue;
+            }
+            if (!loadWindow.intersects(rect)) {
+                m_loadScheduler->cancel(index);
+                continue;
+            }
+            
+            // Anything on screen beats anything off screen; among those the
+            // posters nearest the focus go first
+            qreal dx = qMax(0.0, qMax(viewport.left() - rect.right(), rect.left() - viewport.right()));
+            qreal dy = qMax(0.0, qMax(viewport.top() - rect.bottom(), rect.top() - viewport.bottom()));
+            QPointF fromFocus = rect.center() - focusCenter;
+            qreal priority = (dx + dy) * 4 + qAbs(fromFocus.x()) + qAbs(fromFocus.y());
+            
+            m_loadScheduler->schedule(index, priority);
         }
     }
+}
+
+// Tracks the direction and pace of D-pad browsing for prefetchPriorities()
+void CustomImageListView::recordNavigation(NavigationDirection direction)
+{
+    // Repeated presses in one direction average their interval; a change of
+    // direction or a pause starts over at browsing pace
+    const qint64 idleInterval = 1000;
+    qint64 interval = idleInterval;
+    if (m_navigationClock.isValid()) {
+        interval = m_navigationClock.restart();
+    } else {
+        m_navigationClock.start();
+    }
     
-    qDebug() << "Loading" << visibleIndices.size() << "visible images first, then" 
-             << offscreenIndices.size() << "offscreen images";
+    if (direction == m_navigationDirection && interval < idleInterval) {
+        m_navigationInterval = 0.7 * m_navigationInterval + 0.3 * interval;
+    } else {
+        m_navigationInterval = idleInterval;
+    }
+    m_navigationDirection = direction;
+}
+
+// Posters focus is about to reach, given the last navigation direction:
+// the next ones along the row when moving sideways, the landing column and its
+// neighbours in the next row(s) when moving vertically. Holding a key
+// deepens the lookahead up to three times prefetchDepth.
+QHash<int, qreal> CustomImageListView::prefetchPriorities() const
+{
+    QHash<int, qreal> priorities;
     
-    // First load all visible images
-    for (int index : visibleIndices) {
-        loadImage(index);
+    int categoryIndex = m_itemCategories.value(m_currentIndex, -1);
+    if (m_prefetchDepth <= 0 || categoryIndex < 0 || m_navigationDirection == NavigateNone) {
+        return priorities;
     }
     
-    // Then queue off-screen images with a delay to prevent blocking UI
-    for (int i = 0; i < offscreenIndices.size(); i++) {
-        int index = offscreenIndices[i];
-        // Spread out loading of offscreen images to prevent overloading
-        QTimer::singleShot(50 * (i + 1), this, [this, index]() {
-            if (!m_isBeingDestroyed) {
-                loadImage(index);
+    qreal speedFactor = qBound(1.0, 400.0 / qMax(1.0, m_navigationInterval), 3.0);
+    int depth = qRound(m_prefetchDepth * speedFactor);
+    
+    // Ahead of every offscreen poster, and ahead of visible ones that are far
+    // from the focus; the step about to be taken comes first
+    const qreal stepCost = 50;
+    
+    if (m_navigationDirection == NavigateLeft || m_navigationDirection == NavigateRight) {
+        const QVector<int> &row = m_rowItemIndices.value(categoryIndex);
+        int step = m_navigationDirection == NavigateRight ? 1 : -1;
+        int column = m_itemColumns.value(m_currentIndex);
+        for (int k = 1; k <= depth; ++k) {
+            int target = column + k * step;
+            if (target < 0 || target >= row.size()) {
+                break;
             }
+            priorities.insert(row[target], k * stepCost);
+        }
+        return priorities;
+    }
+    
+    // Vertical moves land on the poster nearest the middle of the target
+    // row's current scroll position, as navigateUp/navigateDown pick it
+    int step = m_navigationDirection == NavigateDown ? 1 : -1;
+    int rowsAhead = speedFactor > 2.0 ? 2 : 1;
+    for (int r = 1; r <= rowsAhead; ++r) {
+        int targetRow = categoryIndex + r * step;
+        if (targetRow < 0 || targetRow >= m_rowTitles.size()) {
+            break;
+        }
+        const QVector<int> &row = m_rowItemIndices.value(targetRow);
+        if (row.isEmpty()) {
+            continue;
+        }
+        
+        CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[targetRow]);
+        qreal stride = dims.posterWidth + dims.itemSpacing;
+        qreal centerX = getCategoryContentX(m_rowTitles[targetRow]) + width() / 2.0;
+        int landing = stride > 0 ? qRound((centerX - m_startPositionX - 10 - dims.posterWidth / 2.0) / stride) : 0;
+        landing = qBound(0, landing, row.size() - 1);
+        
+        // The landing poster, then outwards since the next move is sideways
+        priorities.insert(row[landing], r * stepCost);
+        for (int k = 1; k <= depth / 2; ++k) {
+            qreal priority = (r + k) * stepCost;
+            if (landing + k < row.size()) {
+                priorities.insert(row[landing + k], priority);
+            }
+            if (landing - k >= 0) {
+                priorities.insert(row[landing - k], priority);
+            }
+        }
+    }
+    return priorities;
+}
+
+void CustomImageListView::setPrefetchDepth(int depth)
+{
+    depth = qMax(0, depth);
+    if (m_prefetchDepth != depth) {
+        m_prefetchDepth = depth;
+        emit prefetchDepthChanged();
+        scheduleLoadPriorityUpdate();
+    }
+}
+
+// Coalesces the scroll steps and focus moves of one event loop pass
+void CustomImageListView::scheduleLoadPriorityUpdate()
+{
+    if (!m_loadPriorityUpdateScheduled) {
+        m_loadPriorityUpdateScheduled = true;
+        QTimer::singleShot(0, this, [this]() {
+            updateLoadPriorities();
         });
     }
 }
 
+// Called when a load the scheduler had started is withdrawn
+void CustomImageListView::cancelImageLoad(int index)
+{
+    // Neither reports back, so no fallback texture replaces the poster
+    m_imageFetcher->cancel(index);
+    m_imageDecoder->cancel(index);
+    
+    // Indices waiting on this load are queued again and one of them takes it over
+    if (!takePosterWaiters(index).isEmpty()) {
+        scheduleLoadPriorityUpdate();
+    }
+}
+
 // Add this new method to determine which indices are visible
 QVector<int> CustomImageListView::getVisibleIndices()
 {
@@ -278,13 +491,8 @@ void CustomImageListView::safeReleaseTextures()
 {
     QMutexLocker locker(&m_loadMutex);
     
-    // Only delete nodes, not textures
-    for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
-        if (it.value().node) {
-            delete it.value().node;
-        }
-    }
-    m_nodes.clear();
+    // Poster nodes belong to the scene graph tree; only drop the texture records
+    cleanupTextures();
 }
 
 
@@ -292,11 +500,9 @@ void CustomImageListView::setCount(int count)
 {
     if (m_count != count) {
         m_count = count;
-        for(int i = 0; i < m_count; i++) {
-            loadImage(i);
-        }
+        scheduleLoadPriorityUpdate();
         emit countChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -305,7 +511,7 @@ void CustomImageListView::setItemWidth(qreal width)
     if (m_itemWidth != width) {
         m_itemWidth = width;
         emit itemWidthChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -314,7 +520,7 @@ void CustomImageListView::setItemHeight(qreal height)
     if (m_itemHeight != height) {
         m_itemHeight = height;
         emit itemHeightChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -323,7 +529,7 @@ void CustomImageListView::setSpacing(qreal spacing)
     if (m_spacing != spacing) {
         m_spacing = spacing;
         emit spacingChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -332,7 +538,7 @@ void CustomImageListView::setRowSpacing(qreal spacing)
     if (m_rowSpacing != spacing) {
         m_rowSpacing = spacing;
         emit rowSpacingChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -416,46 +622,16 @@ QImage CustomImageListView::loadLocalImage(int index) const
     return fallback;
 }
 
-QSGGeometryNode* CustomImageListView::createTexturedRect(const QRectF &rect, QSGTexture *texture, bool isFocused)
-{
-    // Calculate scale factor for focus effect
-    const float scaleFactor = isFocused ? 1.1f : 1.0f;  // 10% larger when focused
-    
-    // Calculate scaled dimensions and center position
-    QRectF scaledRect = rect;
-    if (isFocused) {
-        qreal widthDiff = rect.width() * (scaleFactor - 1.0f);
-        qreal heightDiff = rect.height() * (scaleFactor - 1.0f);
-        scaledRect = QRectF(
-            rect.x() - widthDiff / 2,
-            rect.y() - heightDiff / 2,
-            rect.width() * scaleFactor,
-            rect.height() * scaleFactor
-        );
-    }
-
-    // Create geometry for a textured rectangle
-    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4);
-    geometry->setDrawingMode(GL_TRIANGLE_STRIP);
-
-    QSGGeometry::TexturedPoint2D *vertices = geometry->vertexDataAsTexturedPoint2D();
-    
-    // Set vertex positions using scaled rect
-    vertices[0].set(scaledRect.left(), scaledRect.top(), 0.0f, 0.0f);
-    vertices[1].set(scaledRect.right(), scaledRect.top(), 1.0f, 0.0f);
-    vertices[2].set(scaledRect.left(), scaledRect.bottom(), 0.0f, 1.0f);
-    vertices[3].set(scaledRect.right(), scaledRect.bottom(), 1.0f, 1.0f);
-
-    QSGGeometryNode *node = new QSGGeometryNode;
-    node->setGeometry(geometry);
-    node->setFlag(QSGNode::OwnsGeometry);
-
-    QSGOpaqueTextureMaterial *material = new QSGOpaqueTextureMaterial;
-    material->setTexture(texture);
-    
-    node->setMaterial(material);
-    node->setFlag(QSGNode::OwnsMaterial);
+// Focused posters are drawn 10% larger by the focus node
+static const qreal focusScaleFactor = 1.1;
 
+TexturedRectNode* CustomImageListView::createTexturedRect(const QRectF &rect, QSGTexture *texture,
+                                                           const QRectF &sourceRect)
+{
+    TexturedRectNode *node = new TexturedRectNode;
+    node->setRect(rect);
+    node->setSourceRect(sourceRect);
+    node->setTexture(texture);
     return node;
 }
 
@@ -494,8 +670,27 @@ void CustomImageListView::loadImage(int index)
         return;
     }
 
-    // Prevent duplicate texture creation
-    if (m_nodes.contains(index) && m_nodes[index].texture) {
+    // Prevent duplicate texture creation or a second load of the same item
+    if ((m_nodes.contains(index) && m_nodes[index].texture) || m_imageDecoder->isPending(index)
+            || m_imageFetcher->isPending(index) || m_waitingPosterKeys.contains(index)
+            || m_queuedUploadKeys.contains(index)) {
+        return;
+    }
+
+    // The same image at the same size is uploaded once and shared by every
+    // index showing it; an index whose image is already on its way waits
+    // for that load instead of starting another one
+    QString key = posterKey(index);
+    TextureCache *cache = textureCache();
+    if (cache && cache->contains(key)) {
+        setItemTexture(index, key);
+        invalidateItem(index);
+        return;
+    }
+    QList<int> &waiters = m_posterWaiters[key];
+    waiters.append(index);
+    m_waitingPosterKeys.insert(index, key);
+    if (waiters.size() > 1) {
         return;
     }
 
@@ -505,29 +700,101 @@ void CustomImageListView::loadImage(int index)
     const ImageData &imgData = m_imageData[index];
     QString imagePath = imgData.url;
 
-    // First try to load as local resource
-    QImage image = loadLocalImageFromPath(imagePath);
-    if (!image.isNull()) {
-        processLoadedImage(index, image);
-        m_isLoading = false;
-        return;
-    }
-
-    // If not a local resource, try as network URL
     QUrl url(imagePath);
     if (url.scheme().startsWith("http") || imagePath.startsWith("//")) {
         // Convert // URLs to http://
         if (imagePath.startsWith("//")) {
             url = QUrl("http:" + imagePath);
         }
-        loadUrlImage(index, url);
+
+        // Posters evicted from the texture cache come back from memory first
+        QImage cached = m_urlImageCache.find(key);
+        emit urlImageCacheStatsChanged();
+        if (!cached.isNull()) {
+            processLoadedImage(index, cached);
+            m_isLoading = false;
+            return;
+        }
+
+        // A thumbnail stored by an earlier run is already scaled and in the
+        // atlas format; it goes straight to the texture from the mapped file
+        QImage thumbnail = m_thumbnailCache->load(url, posterTargetSize(index), posterImageFormat(index));
+        if (!thumbnail.isNull()) {
+            processLoadedImage(index, thumbnail);
+        } else {
+            loadUrlImage(index, url);
+        }
     } else {
-        createFallbackTexture(index);
+        // Local resource: read, decode and scale on the decoder's pool, the
+        // result comes back through onImageDecoded()
+        m_imageDecoder->decodeFile(index, imagePath, posterTargetSize(index), posterImageFormat(index));
     }
 
     m_isLoading = false;
 }
 
+// Identifies a poster texture by its source and the size it is decoded at
+QString CustomImageListView::posterKey(int index) const
+{
+    QSize size = posterTargetSize(index);
+    QString key = m_imageData.value(index).url + QLatin1Char('@') + QString::number(size.width())
+            + QLatin1Char('x') + QString::number(size.height());
+    
+    QImage::Format format = posterImageFormat(index);
+    if (format != QImage::Format_RGBA8888_Premultiplied) {
+        key += QLatin1Char('#');
+        key += QString::number(int(format));
+    }
+    return key;
+}
+
+// Format the decoder and atlas store index's poster in
+QImage::Format CustomImageListView::posterImageFormat(int index) const
+{
+    int format = m_posterFormat;
+    if (index >= 0 && index < m_imageData.size()) {
+        format = m_rowPosterFormats.value(m_imageData[index].category, format).toInt();
+    }
+    
+    switch (format) {
+    case PosterRgb888:
+        return QImage::Format_RGB888;
+    case PosterRgb565:
+        return QImage::Format_RGB16;
+    default:
+        return QImage::Format_RGBA8888_Premultiplied;
+    }
+}
+
+// Ends the wait of every index sharing index's in-flight load and returns the
+// ones other than index
+QList<int> CustomImageListView::takePosterWaiters(int index)
+{
+    QString key = m_waitingPosterKeys.take(index);
+    if (key.isNull()) {
+        return QList<int>();
+    }
+    
+    QList<int> waiters = m_posterWaiters.take(key);
+    waiters.removeAll(index);
+    for (int waiter : waiters) {
+        m_waitingPosterKeys.remove(waiter);
+    }
+    return waiters;
+}
+
+// Slot size the poster is drawn at, so images are decoded no larger than needed
+QSize CustomImageListView::posterTargetSize(int index) const
+{
+    if (index >= 0 && index < m_imageData.size()) {
+        CategoryDimensions dims = getDimensionsForCategory(m_imageData[index].category);
+        if (dims.posterWidth > 0 && dims.posterHeight > 0) {
+            return QSize(dims.posterWidth, dims.posterHeight);
+        }
+    }
+    return QSize(m_itemWidth, m_itemHeight);
+}
+
 bool CustomImageListView::ensureValidWindow() const
 {
     return window() && window()->isExposed() && !m_isDestroying;
@@ -535,6 +802,14 @@ bool CustomImageListView::ensureValidWindow() const
 
 void CustomImageListView::createFallbackTexture(int index)
 {
+    m_loadScheduler->finish(index);
+    
+    // The fallback is labelled per item, so each waiter gets its own
+    const QList<int> waiters = takePosterWaiters(index);
+    for (int waiter : waiters) {
+        createFallbackTexture(waiter);
+    }
+    
     // Create a basic RGB texture
     QImage fallback(m_itemWidth, m_itemHeight, QImage::Format_RGB32);
     fallback.fill(Qt::darkGray);
@@ -546,36 +821,166 @@ void CustomImageListView::createFallbackTexture(int index)
                     QString("Image %1").arg(index + 1));
     painter.end();
     
-    if (window()) {
-        QSGTexture *texture = window()->createTextureFromImage(fallback);
-        if (texture) {
-            TexturedNode node;
-            node.texture = texture;
-            node.node = nullptr;
-            m_nodes[index] = node;
-            update();
-            qDebug() << "Created fallback texture for index:" << index;
+    // Stored in the row's poster format, so it shares the posters' atlas
+    // instead of opening an RGBA page for one grey rectangle
+    QImage::Format format = posterImageFormat(index);
+    fallback = fallback.convertToFormat(format);
+    
+    // Keyed per item, since the label differs. Uploaded like any poster, on
+    // the render thread within a frame's budget.
+    QString key = QString("fallback:%1@%2x%3#%4").arg(index).arg(m_itemWidth).arg(m_itemHeight)
+            .arg(int(format));
+    queueUpload(key, fallback, QList<int>() << index);
+}
+
+// The window's shared texture cache, joined on first use
+TextureCache *CustomImageListView::textureCache()
+{
+    if (!m_textureCache && window()) {
+        m_textureCache = TextureCache::forWindow(window());
+        m_textureCache->setMaxBytes(m_textureMemoryBudget);
+    }
+    return m_textureCache.data();
+}
+
+// Uploads image into the cache, giving up offscreen posters when the budget
+// has no room left for it: one at a time, coldest first, until the insert
+// succeeds. The cache charges atlas pages in full, so only a retried insert
+// tells whether the space a release frees is enough.
+bool CustomImageListView::insertTexture(const QString &key, const QImage &image)
+{
+    TextureCache *cache = textureCache();
+    if (!cache) {
+        return false;
+    }
+    
+    bool inserted = cache->insert(key, image);
+    if (!inserted) {
+        const QList<int> cold = coldPosterIndices();
+        int released = 0;
+        for (int index : cold) {
+            releasePoster(index);
+            ++released;
+            if (cache->insert(key, image)) {
+                inserted = true;
+                break;
+            }
         }
+        qDebug() << "Texture budget: released" << released << "offscreen posters for" << key
+                 << (inserted ? "" : "without making room");
     }
+    updateTextureMemoryStats();
+    return inserted;
 }
 
-QImage CustomImageListView::loadLocalImageFromPath(const QString &path) const
+// Textured posters outside the viewport grown by the overscan margin, the
+// furthest first. Posters inside the margin are kept in the tree by the
+// culling code because they are about to scroll in, and posters on the
+// prefetch path count as nearest.
+QList<int> CustomImageListView::coldPosterIndices() const
 {
-    QFile file(path);
-    if (file.open(QIODevice::ReadOnly)) {
-        QByteArray imageData = file.readAll();
-        QImage image;
-        if (image.loadFromData(imageData)) {
-            qDebug() << "Successfully loaded image from:" << path;
-            qDebug() << "Image size:" << image.size();
-            file.close();
-            return image;
+    const QRectF viewport = QRectF(0, 0, width(), height())
+            .adjusted(-m_overscanMargin, -m_overscanMargin, m_overscanMargin, m_overscanMargin);
+    const QVector<qreal> rowY = rowPositions();
+    const QHash<int, qreal> prefetch = prefetchPriorities();
+    
+    QVector<QPair<qreal, int>> candidates;
+    for (auto it = m_nodes.constBegin(); it != m_nodes.constEnd(); ++it) {
+        int categoryIndex = m_itemCategories.value(it.key(), -1);
+        if (!it.value().texture || categoryIndex < 0 || categoryIndex >= rowY.size()) {
+            continue;
         }
-        file.close();
+        
+        QRectF rect = posterRect(categoryIndex, m_itemColumns.value(it.key()))
+                .translated(-getCategoryContentX(m_rowTitles[categoryIndex]), rowY[categoryIndex]);
+        if (viewport.intersects(rect)) {
+            continue;
+        }
+        
+        qreal dx = qMax(0.0, qMax(viewport.left() - rect.right(), rect.left() - viewport.right()));
+        qreal dy = qMax(0.0, qMax(viewport.top() - rect.bottom(), rect.top() - viewport.bottom()));
+        qreal distance = prefetch.contains(it.key()) ? 0 : dx + dy;
+        candidates.append(qMakePair(distance, it.key()));
+    }
+    std::sort(candidates.begin(), candidates.end());
+    
+    QList<int> indices;
+    for (int i = candidates.size() - 1; i >= 0; --i) {
+        indices.append(candidates[i].second);
+    }
+    return indices;
+}
+
+// Drops index's texture; the cache evicts it once nothing else holds it and
+// the poster loads again when it comes back into view
+void CustomImageListView::releasePoster(int index)
+{
+    releaseItemTexture(index);
+    m_nodes.remove(index);
+    invalidateItem(index);
+}
+
+// Releases cold posters until the cache is back within the budget, e.g.
+// after the budget was lowered. Released textures are evicted right away,
+// so the total is exact here.
+void CustomImageListView::releaseColdTextures()
+{
+    if (!m_textureCache) {
+        return;
     }
+    
+    const QList<int> cold = coldPosterIndices();
+    for (int index : cold) {
+        if (m_textureCache->totalBytes() <= m_textureMemoryBudget) {
+            break;
+        }
+        releasePoster(index);
+    }
+}
+
+void CustomImageListView::updateTextureMemoryStats()
+{
+    qint64 usage = m_textureCache ? m_textureCache->totalBytes() : 0;
+    qint64 peak = qMax(m_textureMemoryPeak, m_textureCache ? m_textureCache->peakBytes() : 0);
+    if (m_textureMemoryUsage != usage || m_textureMemoryPeak != peak) {
+        m_textureMemoryUsage = usage;
+        m_textureMemoryPeak = peak;
+        emit textureMemoryChanged();
+    }
+}
+
+// Points index at the cached texture for key and takes a reference on it
+bool CustomImageListView::setItemTexture(int index, const QString &key)
+{
+    TextureCache *cache = textureCache();
+    if (!cache) {
+        return false;
+    }
+    
+    // Acquire before the release, which may drop the same texture
+    TextureCache::Handle handle = cache->acquire(key);
+    if (handle.isNull()) {
+        return false;
+    }
+    releaseItemTexture(index);
+    
+    TexturedNode node;
+    node.texture = handle.texture;
+    node.sourceRect = handle.sourceRect;
+    m_nodes[index] = node;
+    m_itemPosterKeys.insert(index, key);
+    return true;
+}
 
-    qDebug() << "Failed to load image from:" << path;
-    return QImage();
+// Drops index's reference on its texture; the cache keeps it for reuse until
+// its budget needs the space
+void CustomImageListView::releaseItemTexture(int index)
+{
+    QString key = m_itemPosterKeys.take(index);
+    if (!key.isNull() && m_textureCache) {
+        m_textureCache->release(key);
+        updateTextureMemoryStats();
+    }
 }
 
 // Update loadUrlImage method to better handle HTTP requests
@@ -594,7 +999,7 @@ void CustomImageListView::loadUrlImage(int index, const QUrl &url)
     }
 
     // For HTTP URLs
-    if (finalUrl.scheme() == "http") {
+    if (finalUrl.scheme() == "http" || finalUrl.scheme() == "https") {
         qDebug() << "Loading image" << index << "from URL:" << finalUrl.toString();
         
         // Create network request
@@ -607,27 +1012,12 @@ void CustomImageListView::loadUrlImage(int index, const QUrl &url)
         
         // Enable redirect following
         request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
-        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
-        
-        QNetworkReply* oldReply = nullptr;
-        
-        // Only lock mutex for the map operations
-        {
-            QMutexLocker locker(&m_networkMutex);
-            
-            // Store old reply for later deletion outside the lock
-            if (m_pendingRequests.contains(index)) {
-                oldReply = m_pendingRequests.take(index);
-            }
-        }
-        
-        // Cancel old request outside the mutex lock
-        if (oldReply) {
-            oldReply->disconnect(); // Prevent callbacks
-            oldReply->abort();
-            oldReply->deleteLater();
-        }
-      
+
+        // Go through the disk cache: fresh entries (Cache-Control / Expires)
+        // are served without a request, stale ones are revalidated with
+        // If-None-Match / If-Modified-Since and a 304 is answered from disk
+        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+        request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
       
     #ifndef QT_NO_SSL
         if (finalUrl.scheme() == "https") {
@@ -638,24 +1028,10 @@ void CustomImageListView::loadUrlImage(int index, const QUrl &url)
         }
     #endif
           
-        // Create network reply
-        QNetworkReply *reply = m_networkManager->get(request);
-        
-        // Store the reply in our map with minimal lock time
-        {
-            QMutexLocker locker(&m_networkMutex);
-            m_pendingRequests[index] = reply;
-        }
-        
-        // Connect signals with Qt 5.6 compatible syntax
-        connect(reply, SIGNAL(finished()), this, SLOT(onNetworkReplyFinished()));
-        connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), 
-                this, SLOT(onNetworkError(QNetworkReply::NetworkError)));
-        connect(reply, SIGNAL(sslErrors(QList<QSslError>)), 
-                reply, SLOT(ignoreSslErrors()));
-        
-        // Add longer timeout for slower connections
-        QTimer::singleShot(30000, reply, SLOT(abort()));
+        // Queued behind the global and per-host limits; replaces an earlier
+        // download of the same poster. The result comes back through
+        // onImageFetched() or onImageFetchFailed().
+        m_imageFetcher->fetch(index, request);
     } else {
         qWarning() << "Unsupported URL scheme:" << finalUrl.scheme();
         createFallbackTexture(index);
@@ -666,33 +1042,123 @@ void CustomImageListView::loadUrlImage(int index, const QUrl &url)
 
 void CustomImageListView::processLoadedImage(int index, const QImage &image)
 {
-    if (!image.isNull() && window()) {
-        // Convert image to optimal format for textures
-        QImage optimizedImage = image.convertToFormat(QImage::Format_RGBA8888);
-        
-        // Scale maintaining aspect ratio
-        QImage scaledImage = optimizedImage.scaled(m_itemWidth, m_itemHeight,
-                                                 Qt::KeepAspectRatio,
-                                                 Qt::SmoothTransformation);
-        
-        // Create texture with proper flag (corrected syntax)
-        QSGTexture *texture = window()->createTextureFromImage(
-            scaledImage,
-            QQuickWindow::TextureHasAlphaChannel
-        );
-
-        if (texture) {
-            // Update the node map
-            TexturedNode node;
-            node.texture = texture;
-            node.node = nullptr;
-            m_nodes[index] = node;
-            
-            qDebug() << "Created texture for image" << index 
-                     << "size:" << scaledImage.size();
-            
-            update(); // Request new frame
+    m_loadScheduler->finish(index);
+    
+    QList<int> indices = takePosterWaiters(index);
+    indices.prepend(index);
+    QString key = posterKey(index);
+    
+    TextureCache *cache = textureCache();
+    if (cache && cache->contains(key)) {
+        // Uploaded meanwhile, e.g. by another view of the window
+        for (int i : indices) {
+            setItemTexture(i, key);
+            invalidateItem(i);
         }
+        return;
+    }
+    
+    if (image.isNull() || !cache) {
+        // Nothing to share; the waiters start loads of their own
+        if (indices.size() > 1) {
+            scheduleLoadPriorityUpdate();
+        }
+        return;
+    }
+    
+    // Images from the decoder arrive converted and scaled already, which
+    // makes this a no-op for them
+    QImage scaledImage = ImageDecoder::prepareForTexture(image, posterTargetSize(index),
+                                                         posterImageFormat(index));
+    queueUpload(key, scaledImage, indices);
+}
+
+// Holds a finished image until a frame has upload budget left for it; the
+// posters keep their placeholder until then. The GL texture itself is only
+// created on the render thread, when updatePaintNode() commits the cache.
+void CustomImageListView::queueUpload(const QString &key, const QImage &image, const QList<int> &indices)
+{
+    for (int index : indices) {
+        m_queuedUploadKeys.insert(index, key);
+    }
+    
+    // Indices sharing an image join its entry
+    for (PendingUpload &upload : m_uploadQueue) {
+        if (upload.key == key) {
+            upload.indices += indices;
+            return;
+        }
+    }
+    
+    PendingUpload upload;
+    upload.key = key;
+    upload.image = image;
+    upload.indices = indices;
+    m_uploadQueue.append(upload);
+    
+    // Ask for a frame, whose afterAnimating() drains the queue
+    if (window()) {
+        window()->update();
+    }
+}
+
+// Runs on the GUI thread before each frame is synchronized. Uploads at most
+// maxUploadsPerFrame images or maxUploadBytesPerFrame bytes, oldest first,
+// and leaves the rest for the following frames. The first image of a frame
+// always goes, so one larger than the byte budget cannot stall the queue.
+// An image the memory budget has no room for is dropped and its posters keep
+// their placeholder; the load scheduler asks for them again on the next
+// scroll or budget change, when they may fit.
+void CustomImageListView::drainUploadQueue()
+{
+    if (m_isBeingDestroyed || m_uploadQueue.isEmpty()) {
+        return;
+    }
+    
+    int uploads = 0;
+    qint64 bytes = 0;
+    while (!m_uploadQueue.isEmpty()) {
+        qint64 size = m_uploadQueue.first().image.byteCount();
+        if (uploads > 0 && (uploads >= m_maxUploadsPerFrame || bytes + size > m_maxUploadBytesPerFrame)) {
+            break;
+        }
+        
+        PendingUpload upload = m_uploadQueue.takeFirst();
+        
+        // Only the indices still waiting for this image; the others were
+        // released or reloaded meanwhile
+        QList<int> indices;
+        for (int index : upload.indices) {
+            auto it = m_queuedUploadKeys.find(index);
+            if (it != m_queuedUploadKeys.end() && it.value() == upload.key) {
+                m_queuedUploadKeys.erase(it);
+                indices.append(index);
+            }
+        }
+        if (indices.isEmpty()) {
+            continue;
+        }
+        
+        if (!insertTexture(upload.key, upload.image)) {
+            // Nothing reached the GPU, so the frame's budget is untouched.
+            // The indices are no longer queued, so they load again once
+            // scrolling has turned other posters cold.
+            continue;
+        }
+        
+        for (int index : indices) {
+            setItemTexture(index, upload.key);
+            invalidateItem(index);
+        }
+        qDebug() << "Created texture for image" << indices.first()
+                 << "size:" << upload.image.size() << "shared by" << indices.size();
+        ++uploads;
+        bytes += size;
+    }
+    
+    // The next frame continues with the rest
+    if (!m_uploadQueue.isEmpty() && window()) {
+        window()->update();
     }
 }
 
@@ -701,7 +1167,7 @@ void CustomImageListView::setImageTitles(const QStringList &titles)
     if (m_imageTitles != titles) {
         m_imageTitles = titles;
         emit imageTitlesChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -709,309 +1175,560 @@ void CustomImageListView::setRowTitles(const QStringList &titles)
 {
     if (m_rowTitles != titles) {
         m_rowTitles = titles;
+        rebuildRowItemIndices();
         emit rowTitlesChanged();
-        update();
+        invalidateLayout();
     }
 }
 
-QSGGeometryNode* CustomImageListView::createOptimizedTextNode(const QString &text, const QRectF &rect)
+TexturedRectNode* CustomImageListView::createRowTitleNode(const QString &text, const QRectF &rect)
 {
     if (!window()) {
         return nullptr;
     }
 
-    // Create new texture for text (don't use caching for now)
-    int width = qMax(1, static_cast<int>(std::ceil(rect.width())));
+    // Calculate title width based on text content
+    static const QFont titleFont("Roboto", 20, QFont::Bold);  // Using Roboto font, size 20, bold
+    static const QFontMetrics fm(titleFont);
+    int textWidth = fm.width(text) + 20;  // Add 20px padding
+    int width = qMax(textWidth, static_cast<int>(std::ceil(rect.width())));
     int height = qMax(1, static_cast<int>(std::ceil(rect.height())));
-    
-    QImage textImage(width, height, QImage::Format_ARGB32_Premultiplied);
-    if (textImage.isNull()) {
+
+    // Rasterized only the first time this exact title is requested
+    TitleTextureCache::Key key;
+    key.text = text;
+    key.font = titleFont;
+    key.color = QColor("#ebebeb");  // Set focus color
+    key.size = QSize(width, height);
+
+    QSGTexture *texture = m_titleCache->acquire(key, window());
+    if (!texture) {
+        return nullptr;
+    }
+
+    // Create adjusted rect with 8 pixels left offset; the texture stays with
+    // the cache, the caller hands the reference to the row
+    QRectF adjustedRect(rect.x() - 8, rect.y(), textWidth, rect.height());
+    return createTexturedRect(adjustedRect, texture);
+}
+
+// Fix the return type from void to QSGNode*
+QSGNode* CustomImageListView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    // Return null immediately if we're being destroyed to prevent render thread from accessing nodes
+    if (m_isBeingDestroyed || !window() || !window()->isExposed()) {
+        if (oldNode) {
+            // Use a safer way to delete the node tree that won't crash during render
+            oldNode->markDirty(QSGNode::DirtySubtreeBlocked); // Block rendering of this subtree
+            
+            // Schedule node deletion for next frame when render thread is done with it
+            QQuickWindow *win = window();
+            if (win) {
+                // Create and schedule a SafeNodeDeleter to handle cleanup
+                win->scheduleRenderJob(new SafeNodeDeleter(oldNode), 
+                                     QQuickWindow::BeforeSynchronizingStage);
+            }
+            
+            // Don't delete here - let the scene graph handle it
+            return nullptr;
+        }
         return nullptr;
     }
     
-    textImage.fill(QColor(0, 0, 0, 0));
+    ImageListRootNode *rootNode = static_cast<ImageListRootNode*>(oldNode);
+    if (!rootNode) {
+        rootNode = new ImageListRootNode;
+        m_layoutDirty = true;
+    }
     
-    QPainter painter;
-    if (!painter.begin(&textImage)) {
-        return nullptr;
+    // Switching the row mode rebuilds every row from scratch
+    if (rootNode->mergedRows != m_mergedRows) {
+        const QList<int> categories = rootNode->rows.keys();
+        for (int categoryIndex : categories) {
+            rootNode->deleteRow(categoryIndex);
+        }
+        rootNode->mergedRows = m_mergedRows;
+        m_layoutDirty = true;
     }
-
-    static const QFont itemFont("Arial", 12);
-    painter.setFont(itemFont);
-    painter.setPen(Qt::white);
-    painter.setRenderHints(QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
-    painter.drawText(textImage.rect(), Qt::AlignCenter, text);
-    painter.end();
     
-    QSGTexture *texture = window()->createTextureFromImage(
-        textImage,
-        QQuickWindow::TextureHasAlphaChannel
-    );
+    // Layout changes (vertical scroll, size, data) walk the visible rows;
+    // horizontal scrolls, texture arrivals and focus moves only patch what
+    // they touched
+    bool focusDirty = m_focusDirty || m_layoutDirty || m_dirtyItems.contains(m_currentIndex);
+    if (m_layoutDirty) {
+        updateAllRows(rootNode);
+    } else {
+        // Scrolled rows first, so slots they add pick up this frame's textures
+        for (int categoryIndex : m_scrolledRows) {
+            CategoryRowNode *rowNode = rootNode->rows.value(categoryIndex, nullptr);
+            if (rowNode && categoryIndex < m_rowTitles.size()) {
+                scrollRowNode(rowNode, categoryIndex);
+            }
+        }
+        if (!m_dirtyItems.isEmpty()) {
+            updateDirtyItems(rootNode);
+        }
+    }
+    
+    // Move the focus highlight last, over the rows it may now sit in
+    if (focusDirty) {
+        updateFocusNode(rootNode);
+    }
+    
+    m_layoutDirty = false;
+    m_focusDirty = false;
+    m_scrolledRows.clear();
+    m_dirtyItems.clear();
+    
+    // A glyph atlas past its page cap starts over: relabel the live rows and
+    // the focus from an empty atlas, then free the old pages, which no label
+    // node points at any more
+    if (m_glyphAtlas->isFull()) {
+        QList<QSGTexture*> oldGlyphPages = m_glyphAtlas->takePages();
+        updateAllRows(rootNode);
+        updateFocusNode(rootNode);
+        qDeleteAll(oldGlyphPages);
+    }
+    
+    // Glyphs first seen by this frame's labels; bind() would upload them too
+    m_glyphAtlas->commitUploads();
+    
+    // Copy newly packed posters into their atlas pages and free evicted
+    // textures. This comes after the rows are patched, so no node still
+    // points at a freed texture; the GL context is current during sync.
+    if (m_textureCache) {
+        m_textureCache->commitUploads();
+    }
     
-    return texture ? createTexturedRect(rect, texture) : nullptr;
+    // Before returning, update metrics with accurate counts
+    if (m_enableNodeMetrics) {
+        int realNodeCount = countNodes(rootNode);
+        qDebug() << "Scene graph node metrics - Nodes:" << realNodeCount;
+        
+        if (m_enableTextureMetrics) {
+            int realTextureCount = countTotalTextures(rootNode);
+            qDebug() << "Scene graph texture metrics - Textures:" << realTextureCount;
+            updateMetricCounts(realNodeCount, realTextureCount);
+        } else {
+            
+            updateMetricCounts(realNodeCount, 0);
+        }
+    }
+    
+    return rootNode;
 }
 
-QSGGeometryNode* CustomImageListView::createRowTitleNode(const QString &text, const QRectF &rect)
+void CustomImageListView::updateAllRows(ImageListRootNode *rootNode)
 {
-    if (!window()) {
-        return nullptr;
+    // Only rows intersecting the viewport, grown by the overscan margin, get nodes
+    const qreal viewTop = -m_overscanMargin;
+    const qreal viewBottom = height() + m_overscanMargin;
+    
+    qreal currentY = -m_contentY;
+    QSet<int> liveRows;
+    
+    for (int categoryIndex = 0; categoryIndex < m_rowTitles.size(); ++categoryIndex) {
+        CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[categoryIndex]);
+        qreal rowHeight = m_titleHeight + 10 + dims.rowHeight;
+        
+        if (currentY + rowHeight >= viewTop && currentY <= viewBottom) {
+            CategoryRowNode *rowNode = rootNode->rows.value(categoryIndex, nullptr);
+            if (!rowNode) {
+                rowNode = new CategoryRowNode;
+                rootNode->appendChildNode(rowNode);
+                rootNode->rows.insert(categoryIndex, rowNode);
+            }
+            
+            // Vertical scrolling only moves the row's transform
+            rowNode->setRowY(currentY);
+            updateRowNode(rowNode, categoryIndex);
+            liveRows.insert(categoryIndex);
+        }
+        
+        currentY += rowHeight + m_rowSpacing;
     }
-
-    // Calculate title width based on text content
-    QFont titleFont("Roboto", 20, QFont::Bold);  // Using Roboto font, size 20, bold
-    QFontMetrics fm(titleFont);
-    int textWidth = fm.width(text) + 20;  // Add 20px padding
-    int width = qMax(textWidth, static_cast<int>(std::ceil(rect.width())));
-    int height = qMax(1, static_cast<int>(std::ceil(rect.height())));
-
-    QImage textImage(width, height, QImage::Format_ARGB32_Premultiplied);
-    if (textImage.isNull()) {
-        return nullptr;
+    
+    // Drop rows that left the viewport or whose categories no longer exist
+    const QList<int> categories = rootNode->rows.keys();
+    for (int categoryIndex : categories) {
+        if (!liveRows.contains(categoryIndex)) {
+            rootNode->deleteRow(categoryIndex);
+        }
     }
+}
 
-    textImage.fill(QColor(0, 0, 0, 0));
-
-    QPainter painter;
-    if (!painter.begin(&textImage)) {
-        return nullptr;
+void CustomImageListView::updateDirtyItems(ImageListRootNode *rootNode)
+{
+    QSet<int> dirtyRows;
+    
+    for (int index : m_dirtyItems) {
+        int categoryIndex = m_itemCategories.value(index, -1);
+        CategoryRowNode *rowNode = rootNode->rows.value(categoryIndex, nullptr);
+        if (!rowNode) {
+            continue;  // Row is culled, it picks the texture up when it comes back
+        }
+        
+        if (m_mergedRows) {
+            // The row's batch is rewritten once however many posters landed in it
+            dirtyRows.insert(categoryIndex);
+            continue;
+        }
+        
+        // Slots exist for every poster in the row's visible column range
+        PosterItemNode *itemNode = rowNode->items.value(index, nullptr);
+        if (itemNode) {
+            updatePosterItem(itemNode, index, posterRect(categoryIndex, m_itemColumns.value(index)));
+        }
+    }
+    
+    for (int categoryIndex : dirtyRows) {
+        updateRowNode(rootNode->rows.value(categoryIndex), categoryIndex);
     }
+}
+
+QRectF CustomImageListView::posterRect(int categoryIndex, int column) const
+{
+    // Same layout as updateRowNode, in the row's scrolled content coordinates
+    CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[categoryIndex]);
+    qreal stride = dims.posterWidth + dims.itemSpacing;
+    return QRectF(m_startPositionX + 10 + column * stride, m_titleHeight + 10,
+                  dims.posterWidth, dims.posterHeight);
+}
 
-    // Configure text rendering with focus properties
-    painter.setFont(titleFont);
-    painter.setPen(QColor("#ebebeb"));  // Set focus color
-    painter.setRenderHints(QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+// Lays out a row in row-local coordinates: the title at y = 0 and the posters
+// below it, unscrolled. Scroll offsets are applied by the row's transforms.
+void CustomImageListView::updateRowNode(CategoryRowNode *rowNode, int categoryIndex)
+{
+    QString categoryName = m_rowTitles[categoryIndex];
+    
+    // Calculate title width based on category name
+    static const QFont titleFont("Arial", 24, QFont::Bold);
+    QFontMetrics fm(titleFont);
+    int titleWidth = fm.width(categoryName) + 20;  // Add 20px padding
+    
+    // Add startPositionX to title position
+    QRectF titleRect(m_startPositionX + 10, 0, titleWidth, m_titleHeight);  // Changed from 5 to 10
+    updateRowTitle(rowNode, categoryName, titleRect);
+    
+    // Horizontal scrolling only moves the content transform
+    qreal scrollX = getCategoryContentX(categoryName);
+    rowNode->setContentX(scrollX);
+    
+    int firstColumn = 0;
+    int lastColumn = -1;
+    visibleColumns(categoryIndex, scrollX, firstColumn, lastColumn);
+    updateRowColumns(rowNode, categoryIndex, firstColumn, lastColumn);
+}
 
-    // Draw text with left alignment and vertical centering
-    int yPos = (height + fm.ascent() - fm.descent()) / 2;
-    painter.drawText(10, yPos, text);
+// Horizontal scroll of a row that is already laid out: move its content
+// transform, and touch the posters and labels only when a column crossed the
+// culling edge
+void CustomImageListView::scrollRowNode(CategoryRowNode *rowNode, int categoryIndex)
+{
+    qreal scrollX = getCategoryContentX(m_rowTitles[categoryIndex]);
+    rowNode->setContentX(scrollX);
     
-    painter.end();
+    int firstColumn = 0;
+    int lastColumn = -1;
+    visibleColumns(categoryIndex, scrollX, firstColumn, lastColumn);
+    if (firstColumn != rowNode->firstColumn || lastColumn != rowNode->lastColumn) {
+        updateRowColumns(rowNode, categoryIndex, firstColumn, lastColumn);
+    }
+}
 
-    // Create texture
-    QSGTexture *texture = window()->createTextureFromImage(
-        textImage,
-        QQuickWindow::TextureHasAlphaChannel
-    );
+// Columns of a row scrolled to scrollX that intersect the viewport plus the
+// overscan margin
+void CustomImageListView::visibleColumns(int categoryIndex, qreal scrollX,
+                                         int &firstColumn, int &lastColumn) const
+{
+    CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[categoryIndex]);
+    qreal firstItemX = m_startPositionX + 10;
+    qreal stride = dims.posterWidth + dims.itemSpacing;
+    
+    qreal visibleLeft = scrollX - m_overscanMargin - firstItemX;
+    qreal visibleRight = scrollX + width() + m_overscanMargin - firstItemX;
+    firstColumn = qMax(0, qCeil((visibleLeft - dims.posterWidth) / stride));
+    lastColumn = qMin(m_rowItemIndices.value(categoryIndex).size() - 1, qFloor(visibleRight / stride));
+}
 
-    if (!texture) {
-        return nullptr;
+// Lays out the posters and labels of the given columns and drops the rest
+void CustomImageListView::updateRowColumns(CategoryRowNode *rowNode, int categoryIndex,
+                                           int firstColumn, int lastColumn)
+{
+    rowNode->firstColumn = firstColumn;
+    rowNode->lastColumn = lastColumn;
+    
+    CategoryDimensions dims = getDimensionsForCategory(m_rowTitles[categoryIndex]);
+    qreal itemY = m_titleHeight + 10; // Changed from 5 to 10 for more spacing after title
+    
+    // Add items using category-specific dimensions with 10-pixel offset (increased from 5)
+    qreal firstItemX = m_startPositionX + 10;  // Changed from 5 to 10
+    qreal stride = dims.posterWidth + dims.itemSpacing;
+    const QVector<int> indices = m_rowItemIndices.value(categoryIndex);
+    
+    // Labels go on top of the posters of either row mode
+    if (m_mergedRows) {
+        updateMergedRow(rowNode, indices, firstColumn, lastColumn, firstItemX, itemY, stride, dims);
+    } else {
+        updatePosterItems(rowNode, indices, firstColumn, lastColumn, firstItemX, itemY, stride, dims);
     }
-
-    // Create adjusted rect with 8 pixels left offset
-    QRectF adjustedRect(rect.x() - 8, rect.y(), textWidth, rect.height());
-    return createTexturedRect(adjustedRect, texture);
+    updatePosterLabels(rowNode, indices, firstColumn, lastColumn, firstItemX, itemY, stride, dims);
 }
 
-// Fix the return type from void to QSGNode*
-QSGNode* CustomImageListView::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+void CustomImageListView::updatePosterItems(CategoryRowNode *rowNode, const QVector<int> &indices,
+                                            int firstColumn, int lastColumn, qreal firstItemX,
+                                            qreal itemY, qreal stride, const CategoryDimensions &dims)
 {
-    // Return null immediately if we're being destroyed to prevent render thread from accessing nodes
-    if (m_isBeingDestroyed || !window() || !window()->isExposed()) {
-        if (oldNode) {
-            // Use a safer way to delete the node tree that won't crash during render
-            oldNode->markDirty(QSGNode::DirtySubtreeBlocked); // Block rendering of this subtree
-            
-            // Schedule node deletion for next frame when render thread is done with it
-            QQuickWindow *win = window();
-            if (win) {
-                // Create and schedule a SafeNodeDeleter to handle cleanup
-                win->scheduleRenderJob(new SafeNodeDeleter(oldNode), 
-                                     QQuickWindow::BeforeSynchronizingStage);
-            }
-            
-            // Don't delete here - let the scene graph handle it
-            return nullptr;
+    QSet<int> liveItems;
+    for (int column = firstColumn; column <= lastColumn; ++column) {
+        int i = indices[column];
+        if (i >= m_count) {
+            continue;
         }
-        return nullptr;
+        
+        PosterItemNode *itemNode = rowNode->items.value(i, nullptr);
+        if (!itemNode) {
+            itemNode = new PosterItemNode;
+            rowNode->contentNode->appendChildNode(itemNode);
+            rowNode->items.insert(i, itemNode);
+        }
+        
+        QRectF rect(firstItemX + column * stride, itemY, dims.posterWidth, dims.posterHeight);
+        updatePosterItem(itemNode, i, rect);
+        liveItems.insert(i);
     }
     
-    QSGNode *parentNode = oldNode ? oldNode : new QSGNode;
-    
-    // Clear old nodes safely
-    while (parentNode->childCount() > 0) {
-        QSGNode *node = parentNode->firstChild();
-        if (node) {
-            parentNode->removeChildNode(node);
-            delete node;
+    // Remove slots for items that were culled or left this category
+    for (auto it = rowNode->items.begin(); it != rowNode->items.end(); ) {
+        if (!liveItems.contains(it.key())) {
+            rowNode->contentNode->removeChildNode(it.value());
+            delete it.value();
+            it = rowNode->items.erase(it);
+        } else {
+            ++it;
         }
     }
+}
+
+void CustomImageListView::updateMergedRow(CategoryRowNode *rowNode, const QVector<int> &indices,
+                                          int firstColumn, int lastColumn, qreal firstItemX,
+                                          qreal itemY, qreal stride, const CategoryDimensions &dims)
+{
+    // Group the visible posters by the texture they sample, one quad each.
+    // Focus is drawn by the focus node, so the batch never changes with it.
+    QHash<QSGTexture*, QVector<MergedPosterNode::Quad>> quadsByTexture;
     
-    qreal currentY = -m_contentY;
-    int currentImageIndex = 0;
-    
-    // Create category containers
-    for (int categoryIndex = 0; categoryIndex < m_rowTitles.size(); ++categoryIndex) {
-        QString categoryName = m_rowTitles[categoryIndex];
-        
-        // Get dimensions for this category
-        CategoryDimensions dims = getDimensionsForCategory(categoryName);
-        
-        // Calculate title width based on category name
-        static const QFont titleFont("Arial", 24, QFont::Bold);
-        QFontMetrics fm(titleFont);
-        int titleWidth = fm.width(categoryName) + 20;  // Add 20px padding
+    for (int column = firstColumn; column <= lastColumn; ++column) {
+        int i = indices[column];
+        if (i >= m_count) {
+            continue;
+        }
         
-        // Add startPositionX to title position
-        QRectF titleRect(m_startPositionX + 10, currentY, titleWidth, m_titleHeight);  // Changed from 5 to 10
-        QSGGeometryNode *titleNode = createRowTitleNode(categoryName, titleRect);
-        if (titleNode) {
-            parentNode->appendChildNode(titleNode);
+        const TexturedNode node = m_nodes.value(i);
+        if (!node.texture) {
+            continue;
         }
-        currentY += m_titleHeight + 10; // Changed from 5 to 10 for more spacing after title
         
-        // Calculate items in this category
-        QVector<ImageData> categoryItems;
-        for (const ImageData &imgData : m_imageData) {
-            if (imgData.category == categoryName) {
-                categoryItems.append(imgData);
-            }
+        MergedPosterNode::Quad quad;
+        quad.rect = QRectF(firstItemX + column * stride, itemY, dims.posterWidth, dims.posterHeight);
+        quad.sourceRect = node.sourceRect;
+        quadsByTexture[node.texture].append(quad);
+    }
+    
+    for (auto it = quadsByTexture.constBegin(); it != quadsByTexture.constEnd(); ++it) {
+        MergedPosterNode *mergedNode = rowNode->mergedNodes.value(it.key(), nullptr);
+        if (!mergedNode) {
+            mergedNode = new MergedPosterNode;
+            mergedNode->setTexture(it.key());
+            rowNode->contentNode->prependChildNode(mergedNode);
+            rowNode->mergedNodes.insert(it.key(), mergedNode);
         }
-
-        // Add items using category-specific dimensions with 10-pixel offset (increased from 5)
-        qreal xPos = m_startPositionX + 10 - getCategoryContentX(categoryName);  // Changed from 5 to 10
-        for (const ImageData &imgData : categoryItems) {
-            if (currentImageIndex < m_count) {
-                QRectF rect(xPos, currentY, dims.posterWidth, dims.posterHeight);
-                
-                // Create item container
-                QSGNode* itemContainer = new QSGNode;
-
-                // Add image with focus effect
-                if (m_nodes.contains(currentImageIndex) && m_nodes[currentImageIndex].texture) {
-                    bool isFocused = (currentImageIndex == m_currentIndex);
-                    QSGGeometryNode *imageNode = createTexturedRect(
-                        rect, 
-                        m_nodes[currentImageIndex].texture,
-                        isFocused
-                    );
-                    if (imageNode) {
-                        itemContainer->appendChildNode(imageNode);
-                        m_nodes[currentImageIndex].node = imageNode;
-                    }
-                }
-
-                // Add selection/focus effects if this is the current item
-                if (currentImageIndex == m_currentIndex) {
-                    addSelectionEffects(itemContainer, rect);
-                }
-
-                // Add title overlay
-                //addTitleOverlay(itemContainer, rect, imgData.title);
-
-                // Add the container to parent
-                parentNode->appendChildNode(itemContainer);
-                currentImageIndex++;
-                xPos += dims.posterWidth + dims.itemSpacing;
-            }
+        mergedNode->setQuads(it.value());
+    }
+    
+    for (auto it = rowNode->mergedNodes.begin(); it != rowNode->mergedNodes.end(); ) {
+        if (!quadsByTexture.contains(it.key())) {
+            rowNode->contentNode->removeChildNode(it.value());
+            delete it.value();
+            it = rowNode->mergedNodes.erase(it);
+        } else {
+            ++it;
         }
-        
-        currentY += dims.rowHeight + m_rowSpacing;
     }
+}
+
+void CustomImageListView::updatePosterLabels(CategoryRowNode *rowNode, const QVector<int> &indices,
+                                             int firstColumn, int lastColumn, qreal firstItemX,
+                                             qreal itemY, qreal stride, const CategoryDimensions &dims)
+{
+    GlyphAtlas::QuadsByTexture quadsByTexture;
     
-    // Before returning, update metrics with accurate counts
-    if (m_enableNodeMetrics) {
-        int realNodeCount = countNodes(parentNode);
-        qDebug() << "Scene graph node metrics - Nodes:" << realNodeCount;
+    if (m_showPosterTitles) {
+        // All label backgrounds of the row in one decoration node
+        if (!rowNode->labelBackgroundNode) {
+            rowNode->labelBackgroundNode = new DecorationNode;
+            rowNode->contentNode->appendChildNode(rowNode->labelBackgroundNode);
+        }
+        rowNode->labelBackgroundNode->clear();
         
-        if (m_enableTextureMetrics) {
-            int realTextureCount = countTotalTextures(parentNode);
-            qDebug() << "Scene graph texture metrics - Textures:" << realTextureCount;
-            updateMetricCounts(realNodeCount, realTextureCount);
-        } else {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            int i = indices[column];
+            if (i >= m_count) {
+                continue;
+            }
             
-            updateMetricCounts(realNodeCount, 0);
+            QRectF rect(firstItemX + column * stride, itemY, dims.posterWidth, dims.posterHeight);
+            appendPosterLabel(i, rect, rowNode->labelBackgroundNode, quadsByTexture);
         }
+        rowNode->labelBackgroundNode->commit();
+    } else if (rowNode->labelBackgroundNode) {
+        rowNode->contentNode->removeChildNode(rowNode->labelBackgroundNode);
+        delete rowNode->labelBackgroundNode;
+        rowNode->labelBackgroundNode = nullptr;
     }
     
-    return parentNode;
+    updateLabelNodes(rowNode->contentNode, rowNode->labelTextNodes, quadsByTexture);
 }
 
-// Helper method for selection effects
-void CustomImageListView::addSelectionEffects(QSGNode* container, const QRectF& rect)
+void CustomImageListView::appendPosterLabel(int index, const QRectF &posterRect, DecorationNode *decorations,
+                                            GlyphAtlas::QuadsByTexture &quadsByTexture)
 {
-    if (m_isBeingDestroyed) return;
-    
-    // Calculate scaled dimensions for focus border to match zoomed asset
-    const float scaleFactor = 1.1f;  // Match the zoom factor from createTexturedRect
-    qreal widthDiff = rect.width() * (scaleFactor - 1.0f);
-    qreal heightDiff = rect.height() * (scaleFactor - 1.0f);
-    
-    QRectF scaledRect(
-        rect.x() - widthDiff / 2,
-        rect.y() - heightDiff / 2,
-        rect.width() * scaleFactor,
-        rect.height() * scaleFactor
-    );
+    if (index >= m_imageData.size() || m_imageData[index].title.isEmpty()) {
+        return;
+    }
     
-    // Create white border effect
-    QSGGeometryNode *borderNode = new QSGGeometryNode;
+    static const QFont labelFont("Arial", 12);
     
-    // Create geometry for border (4 lines forming a rectangle)
-    QSGGeometry *borderGeometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 8);
-    borderGeometry->setDrawingMode(GL_LINES);
-    borderGeometry->setLineWidth(2); // Border width
+    // Semi-transparent background behind the title
+    QRectF textRect(posterRect.left(), posterRect.bottom() - 40, posterRect.width(), 40);
+    decorations->addRect(textRect, QColor(0, 0, 0, 128));
+    m_glyphAtlas->appendText(m_imageData[index].title, labelFont, Qt::white,
+                             textRect.adjusted(6, 0, -6, 0), quadsByTexture);
+}
+
+void CustomImageListView::updateLabelNodes(QSGNode *parent, QHash<QSGTexture*, GlyphTextNode*> &textNodes,
+                                           const GlyphAtlas::QuadsByTexture &quadsByTexture,
+                                           QSGTexture::Filtering filtering)
+{
+    // Glyph quads of all labels, one node per glyph atlas page
+    for (auto it = quadsByTexture.constBegin(); it != quadsByTexture.constEnd(); ++it) {
+        GlyphTextNode *textNode = textNodes.value(it.key(), nullptr);
+        if (!textNode) {
+            textNode = new GlyphTextNode(filtering);
+            textNode->setTexture(it.key());
+            parent->appendChildNode(textNode);
+            textNodes.insert(it.key(), textNode);
+        }
+        textNode->setQuads(it.value());
+    }
     
-    QSGGeometry::Point2D *vertices = borderGeometry->vertexDataAsPoint2D();
+    for (auto it = textNodes.begin(); it != textNodes.end(); ) {
+        if (!quadsByTexture.contains(it.key())) {
+            parent->removeChildNode(it.value());
+            delete it.value();
+            it = textNodes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void CustomImageListView::updateFocusNode(ImageListRootNode *rootNode)
+{
+    // Locate the focused poster's row and column
+    int categoryIndex = -1;
+    int column = -1;
+    if (m_currentIndex >= 0 && m_currentIndex < m_count) {
+        categoryIndex = m_itemCategories.value(m_currentIndex, -1);
+        column = m_itemColumns.value(m_currentIndex, -1);
+    }
     
-    // Top line
-    vertices[0].set(scaledRect.left(), scaledRect.top());
-    vertices[1].set(scaledRect.right(), scaledRect.top());
+    CategoryRowNode *rowNode = rootNode->rows.value(categoryIndex, nullptr);
+    if (!rowNode || column < 0) {
+        // Focused row is culled; park the node until it comes back
+        rootNode->detachFocus();
+        return;
+    }
     
-    // Right line
-    vertices[2].set(scaledRect.right(), scaledRect.top());
-    vertices[3].set(scaledRect.right(), scaledRect.bottom());
+    if (!rootNode->focusNode) {
+        rootNode->focusNode = new FocusNode;
+    }
+    FocusNode *focusNode = rootNode->focusNode;
     
-    // Bottom line
-    vertices[4].set(scaledRect.right(), scaledRect.bottom());
-    vertices[5].set(scaledRect.left(), scaledRect.bottom());
+    if (focusNode->parent() != rowNode->focusLayer) {
+        rootNode->detachFocus();
+        rowNode->focusLayer->appendChildNode(focusNode);
+    }
     
-    // Left line
-    vertices[6].set(scaledRect.left(), scaledRect.bottom());
-    vertices[7].set(scaledRect.left(), scaledRect.top());
+    QRectF rect = posterRect(categoryIndex, column);
+    focusNode->setTarget(m_currentIndex, rect, focusScaleFactor, m_focusAnimationDuration, window());
     
-    borderNode->setGeometry(borderGeometry);
-    borderNode->setFlag(QSGNode::OwnsGeometry);
+    const TexturedNode node = m_nodes.value(m_currentIndex);
+    focusNode->setImage(node.texture, node.sourceRect);
     
-    // Create white material for border
-    QSGFlatColorMaterial *borderMaterial = new QSGFlatColorMaterial;
-    borderMaterial->setColor(QColor(Qt::white));
+    // Label background and frame share one decoration node; the frame is
+    // drawn inside the zoom transform, so undo the zoom on its stroke
+    DecorationNode *decorations = focusNode->decorationNode;
+    decorations->clear();
     
-    borderNode->setMaterial(borderMaterial);
-    borderNode->setFlag(QSGNode::OwnsMaterial);
+    GlyphAtlas::QuadsByTexture quadsByTexture;
+    if (m_showPosterTitles) {
+        appendPosterLabel(m_currentIndex, rect, decorations, quadsByTexture);
+    }
+    decorations->addFrame(rect, m_focusBorderWidth / focusNode->zoom(),
+                          m_focusBorderRadius / focusNode->zoom(), QColor(Qt::white));
+    decorations->commit();
     
-    container->appendChildNode(borderNode);
+    // The label zooms with the poster, so its glyphs are filtered
+    updateLabelNodes(focusNode, focusNode->labelTextNodes, quadsByTexture, QSGTexture::Linear);
 }
 
-// Helper method for title overlay
-void CustomImageListView::addTitleOverlay(QSGNode* container, const QRectF& rect, const QString& title)
+void CustomImageListView::updateRowTitle(CategoryRowNode *rowNode, const QString &text, const QRectF &rect)
 {
-    QRectF textRect(rect.left(), rect.bottom() - 40, rect.width(), 40);
-    
-    // Add semi-transparent background
-    QSGGeometryNode *textBgNode = new QSGGeometryNode;
-    QSGGeometry *bgGeometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 4);
-    bgGeometry->setDrawingMode(GL_TRIANGLE_STRIP);
-    
-    QSGGeometry::Point2D *bgVertices = bgGeometry->vertexDataAsPoint2D();
-    bgVertices[0].set(textRect.left(), textRect.top());
-    bgVertices[1].set(textRect.right(), textRect.top());
-    bgVertices[2].set(textRect.left(), textRect.bottom());
-    bgVertices[3].set(textRect.right(), textRect.bottom());
-    
-    textBgNode->setGeometry(bgGeometry);
-    textBgNode->setFlag(QSGNode::OwnsGeometry);
+    if (rowNode->titleNode && rowNode->titleText == text) {
+        // Same text, only follow the row when it moves
+        if (rect.topLeft() != rowNode->titleRect.topLeft()) {
+            QPointF delta = rect.topLeft() - rowNode->titleRect.topLeft();
+            rowNode->titleNode->setRect(rowNode->titleNode->rect().translated(delta));
+            rowNode->titleRect = rect;
+        }
+        return;
+    }
     
-    QSGFlatColorMaterial *bgMaterial = new QSGFlatColorMaterial;
-    bgMaterial->setColor(QColor(0, 0, 0, 128));
-    textBgNode->setMaterial(bgMaterial);
-    textBgNode->setFlag(QSGNode::OwnsMaterial);
+    if (rowNode->titleNode) {
+        rowNode->removeChildNode(rowNode->titleNode);
+        delete rowNode->titleNode;
+        rowNode->titleNode = nullptr;
+    }
+    // Give the old title back first so an identical title is reused
+    rowNode->setTitleTexture(QSharedPointer<TitleTextureCache>(), nullptr);
     
-    container->appendChildNode(textBgNode);
+    rowNode->titleNode = createRowTitleNode(text, rect);
+    rowNode->titleText = text;
+    rowNode->titleRect = rect;
+    if (rowNode->titleNode) {
+        rowNode->setTitleTexture(m_titleCache, rowNode->titleNode->texture());
+        rowNode->prependChildNode(rowNode->titleNode);
+    }
+}
 
-    // Add text
-    QSGGeometryNode *textNode = createOptimizedTextNode(title, textRect);
-    if (textNode) {
-        container->appendChildNode(textNode);
+void CustomImageListView::updatePosterItem(PosterItemNode *itemNode, int index, const QRectF &rect)
+{
+    QSGTexture *texture = m_nodes.contains(index) ? m_nodes[index].texture : nullptr;
+    
+    // Focus zoom and border are drawn by the focus node on top
+    if (texture) {
+        if (!itemNode->imageNode) {
+            itemNode->imageNode = new TexturedRectNode;
+            itemNode->prependChildNode(itemNode->imageNode);
+        }
+        itemNode->imageNode->setTexture(texture);
+        itemNode->imageNode->setSourceRect(m_nodes[index].sourceRect);
+        itemNode->imageNode->setRect(rect);
+    } else if (itemNode->imageNode) {
+        itemNode->removeChildNode(itemNode->imageNode);
+        delete itemNode->imageNode;
+        itemNode->imageNode = nullptr;
     }
 }
 
@@ -1079,6 +1796,7 @@ void CustomImageListView::itemChange(ItemChange change, const ItemChangeData &da
             if (oldWindow) {
                 disconnect(oldWindow, SIGNAL(beforeRendering()), this, nullptr);
                 disconnect(oldWindow, SIGNAL(afterRendering()), this, nullptr);
+                disconnect(oldWindow, SIGNAL(afterAnimating()), this, nullptr);
                 
                 // Force update to apply visibility change
                 oldWindow->update();
@@ -1137,7 +1855,8 @@ void CustomImageListView::setCurrentIndex(int index)
         }
         
         emit currentIndexChanged();
-        update();
+        invalidateFocus();
+        scheduleLoadPriorityUpdate();
     }
 }
 
@@ -1241,6 +1960,8 @@ bool CustomImageListView::navigateLeft()
         return false;
     }
 
+    recordNavigation(NavigateLeft);
+
     QString currentCategory = m_imageData[m_currentIndex].category;
     int prevIndex = m_currentIndex - 1;
     
@@ -1299,6 +2020,8 @@ void CustomImageListView::navigateRight()
         return;
     }
 
+    recordNavigation(NavigateRight);
+
     QString currentCategory = m_imageData[m_currentIndex].category;
     int nextIndex = m_currentIndex + 1;
     
@@ -1364,6 +2087,8 @@ void CustomImageListView::navigateUp()
         return;
     }
 
+    recordNavigation(NavigateUp);
+
     QString currentCategory = m_imageData[m_currentIndex].category;
     int categoryIndex = m_rowTitles.indexOf(currentCategory);
     
@@ -1482,6 +2207,8 @@ void CustomImageListView::navigateDown()
         return;
     }
 
+    recordNavigation(NavigateDown);
+
     QString currentCategory = m_imageData[m_currentIndex].category;
     int categoryIndex = m_rowTitles.indexOf(currentCategory);
     
@@ -1747,7 +2474,7 @@ void CustomImageListView::setRowCount(int count)
     if (m_rowCount != count) {
         m_rowCount = count;
         emit rowCountChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -1756,7 +2483,7 @@ void CustomImageListView::setContentX(qreal x)
     if (m_contentX != x) {
         m_contentX = x;
         emit contentXChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -1768,7 +2495,7 @@ void CustomImageListView::setContentY(qreal y)
         // Add this call to check visibility on scroll
         handleContentPositionChange();
         
-        update();
+        invalidateLayout();
     }
 }
 
@@ -1841,35 +2568,20 @@ void CustomImageListView::wheelEvent(QWheelEvent *event)
     event->accept();
 }
 
-void CustomImageListView::cleanupNode(TexturedNode& node)
-{
-    if (node.node) {
-        delete node.node;
-        node.node = nullptr;
-    }
-    // Don't delete texture, just clear the pointer
-    node.texture = nullptr;
-}
-
-void CustomImageListView::limitTextureCacheSize(int maxTextures)
-{
-    if (m_nodes.size() > maxTextures) {
-        // Remove oldest textures
-        auto it = m_nodes.begin();
-        while (m_nodes.size() > maxTextures && it != m_nodes.end()) {
-            cleanupNode(it.value());
-            it = m_nodes.erase(it);
-        }
-    }
-}
-
 // Update cleanupTextures
 void CustomImageListView::cleanupTextures()
 {
+    // Queued images were prepared for the textures going away
+    m_uploadQueue.clear();
+    m_queuedUploadKeys.clear();
+    
     for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
-        cleanupNode(it.value());
+        releaseItemTexture(it.key());
     }
     m_nodes.clear();
+    
+    // Every poster node may point at a released texture now
+    m_layoutDirty = true;
 }
 
 void CustomImageListView::setJsonSource(const QUrl &source)
@@ -2071,12 +2783,13 @@ void CustomImageListView::processJsonData(const QByteArray &data)
 
     // Update view
     m_count = m_imageData.size();
+    rebuildRowItemIndices();
     if (m_count > 0) {
         safeReleaseTextures();
         loadAllImages();
         emit countChanged();
         emit rowTitlesChanged();
-        update();
+        invalidateLayout();
     } else {
         qWarning() << "No menu items were loaded!";
         addDefaultItems();
@@ -2100,11 +2813,12 @@ void CustomImageListView::addDefaultItems()
     }
     
     m_count = m_imageData.size();
+    rebuildRowItemIndices();
     safeReleaseTextures();
     loadAllImages();
     emit countChanged();
     emit rowTitlesChanged();
-    update();
+    invalidateLayout();
 }
 
 
@@ -2119,8 +2833,50 @@ void CustomImageListView::setCategoryContentX(const QString& category, qreal x)
             handleContentPositionChange();
         }
         
-        update();
+        // Only this row moves; the other rows and the vertical layout stay
+        int categoryIndex = m_rowTitles.indexOf(category);
+        if (categoryIndex >= 0) {
+            m_scrolledRows.insert(categoryIndex);
+            update();
+        }
+    }
+}
+
+void CustomImageListView::rebuildRowItemIndices()
+{
+    m_rowItemIndices.clear();
+    m_rowItemIndices.resize(m_rowTitles.size());
+    m_itemCategories.fill(-1, m_imageData.size());
+    m_itemColumns.fill(-1, m_imageData.size());
+    
+    for (int i = 0; i < m_imageData.size(); ++i) {
+        int categoryIndex = m_rowTitles.indexOf(m_imageData[i].category);
+        if (categoryIndex >= 0) {
+            m_itemCategories[i] = categoryIndex;
+            m_itemColumns[i] = m_rowItemIndices[categoryIndex].size();
+            m_rowItemIndices[categoryIndex].append(i);
+        }
     }
+    
+    invalidateLayout();
+}
+
+void CustomImageListView::invalidateLayout()
+{
+    m_layoutDirty = true;
+    update();
+}
+
+void CustomImageListView::invalidateItem(int index)
+{
+    m_dirtyItems.insert(index);
+    update();
+}
+
+void CustomImageListView::invalidateFocus()
+{
+    m_focusDirty = true;
+    update();
 }
 
 qreal CustomImageListView::getCategoryContentX(const QString& category) const
@@ -2154,6 +2910,13 @@ void CustomImageListView::setupNetworkManager()
     // Configure network settings for embedded systems
     m_networkManager->setConfiguration(QNetworkConfiguration());
     m_networkManager->setNetworkAccessible(QNetworkAccessManager::Accessible);
+
+    // HTTP response cache; QNetworkAccessManager handles ETag / Last-Modified
+    // revalidation and Cache-Control itself once a cache is set
+    m_httpCache = new QNetworkDiskCache(m_networkManager);
+    m_httpCache->setCacheDirectory(resolvedHttpCacheDirectory());
+    m_httpCache->setMaximumCacheSize(m_httpCacheSize);
+    m_networkManager->setCache(m_httpCache);
     
     // Enable SSL/HTTPS support
     #ifndef QT_NO_SSL
@@ -2249,7 +3012,7 @@ void CustomImageListView::setStartPositionX(qreal x)
     if (m_startPositionX != x) {
         m_startPositionX = x;
         emit startPositionXChanged();
-        update();
+        invalidateLayout();
     }
 }
 
@@ -2271,6 +3034,208 @@ void CustomImageListView::setEnableTextureMetrics(bool enable)
     }
 }
 
+void CustomImageListView::setShowPosterTitles(bool show)
+{
+    if (m_showPosterTitles != show) {
+        m_showPosterTitles = show;
+        emit showPosterTitlesChanged();
+        invalidateLayout();
+    }
+}
+
+void CustomImageListView::setFocusBorderWidth(qreal width)
+{
+    width = qMax(0.0, width);
+    if (m_focusBorderWidth != width) {
+        m_focusBorderWidth = width;
+        emit focusBorderWidthChanged();
+        invalidateFocus();
+    }
+}
+
+void CustomImageListView::setFocusBorderRadius(qreal radius)
+{
+    radius = qMax(0.0, radius);
+    if (m_focusBorderRadius != radius) {
+        m_focusBorderRadius = radius;
+        emit focusBorderRadiusChanged();
+        invalidateFocus();
+    }
+}
+
+void CustomImageListView::setFocusAnimationDuration(int duration)
+{
+    duration = qMax(0, duration);
+    if (m_focusAnimationDuration != duration) {
+        m_focusAnimationDuration = duration;
+        emit focusAnimationDurationChanged();
+    }
+}
+
+QString CustomImageListView::resolvedHttpCacheDirectory() const
+{
+    if (!m_httpCacheDirectory.isEmpty()) {
+        return m_httpCacheDirectory;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http";
+}
+
+void CustomImageListView::setHttpCacheDirectory(const QString &directory)
+{
+    if (m_httpCacheDirectory != directory) {
+        m_httpCacheDirectory = directory;
+        if (m_httpCache) {
+            m_httpCache->setCacheDirectory(resolvedHttpCacheDirectory());
+        }
+        emit httpCacheDirectoryChanged();
+    }
+}
+
+void CustomImageListView::setHttpCacheSize(qint64 size)
+{
+    size = qMax<qint64>(0, size);
+    if (m_httpCacheSize != size) {
+        m_httpCacheSize = size;
+        if (m_httpCache) {
+            m_httpCache->setMaximumCacheSize(size);
+        }
+        emit httpCacheSizeChanged();
+    }
+}
+
+void CustomImageListView::setMaxConcurrentDownloads(int count)
+{
+    count = qMax(1, count);
+    if (m_imageFetcher->maxActive() != count) {
+        m_imageFetcher->setMaxActive(count);
+        emit networkSettingsChanged();
+    }
+}
+
+void CustomImageListView::setMaxDownloadsPerHost(int count)
+{
+    count = qMax(1, count);
+    if (m_imageFetcher->maxPerHost() != count) {
+        m_imageFetcher->setMaxPerHost(count);
+        emit networkSettingsChanged();
+    }
+}
+
+void CustomImageListView::setNetworkTimeout(int ms)
+{
+    ms = qMax(0, ms);
+    if (m_imageFetcher->timeout() != ms) {
+        m_imageFetcher->setTimeout(ms);
+        emit networkSettingsChanged();
+    }
+}
+
+void CustomImageListView::setDownloadRetryCount(int count)
+{
+    count = qMax(0, count);
+    if (m_imageFetcher->maxRetries() != count) {
+        m_imageFetcher->setMaxRetries(count);
+        emit networkSettingsChanged();
+    }
+}
+
+void CustomImageListView::setMaxConcurrentLoads(int count)
+{
+    count = qMax(1, count);
+    if (m_loadScheduler->maxActive() != count) {
+        m_loadScheduler->setMaxActive(count);
+        emit maxConcurrentLoadsChanged();
+    }
+}
+
+void CustomImageListView::setUrlImageCacheSize(qint64 size)
+{
+    size = qMax<qint64>(0, size) / 1024 * 1024;  // The cache accounts in KiB
+    if (m_urlImageCache.maxBytes() != size) {
+        m_urlImageCache.setMaxBytes(size);
+        emit urlImageCacheSizeChanged();
+        emit urlImageCacheStatsChanged();
+    }
+}
+
+void CustomImageListView::setTextureMemoryBudget(qint64 bytes)
+{
+    bytes = qMax<qint64>(0, bytes);
+    if (m_textureMemoryBudget != bytes) {
+        m_textureMemoryBudget = bytes;
+        if (m_textureCache) {
+            m_textureCache->setMaxBytes(bytes);
+            releaseColdTextures();
+            updateTextureMemoryStats();
+        }
+        
+        // Posters refused under the old budget get another chance
+        scheduleLoadPriorityUpdate();
+        emit textureMemoryBudgetChanged();
+    }
+}
+
+void CustomImageListView::setPosterFormat(PosterFormat format)
+{
+    if (m_posterFormat != format) {
+        m_posterFormat = format;
+        emit posterFormatChanged();
+        
+        // Posters reload in the new format as they are scheduled again
+        cleanupTextures();
+        scheduleLoadPriorityUpdate();
+        update();
+    }
+}
+
+void CustomImageListView::setRowPosterFormats(const QVariantMap &formats)
+{
+    if (m_rowPosterFormats != formats) {
+        m_rowPosterFormats = formats;
+        emit posterFormatChanged();
+        cleanupTextures();
+        scheduleLoadPriorityUpdate();
+        update();
+    }
+}
+
+void CustomImageListView::setMaxUploadsPerFrame(int count)
+{
+    count = qMax(1, count);
+    if (m_maxUploadsPerFrame != count) {
+        m_maxUploadsPerFrame = count;
+        emit uploadBudgetChanged();
+    }
+}
+
+void CustomImageListView::setMaxUploadBytesPerFrame(qint64 bytes)
+{
+    bytes = qMax<qint64>(0, bytes);
+    if (m_maxUploadBytesPerFrame != bytes) {
+        m_maxUploadBytesPerFrame = bytes;
+        emit uploadBudgetChanged();
+    }
+}
+
+void CustomImageListView::setMergedRows(bool merged)
+{
+    if (m_mergedRows != merged) {
+        m_mergedRows = merged;
+        emit mergedRowsChanged();
+        invalidateLayout();
+    }
+}
+
+void CustomImageListView::setOverscanMargin(qreal margin)
+{
+    margin = qMax(0.0, margin);
+    if (m_overscanMargin != margin) {
+        m_overscanMargin = margin;
+        emit overscanMarginChanged();
+        invalidateLayout();
+    }
+}
+
 void CustomImageListView::handleContentPositionChange()
 {
     // Don't proceed if we're being destroyed
@@ -2278,20 +3243,8 @@ void CustomImageListView::handleContentPositionChange()
         return;
     }
     
-    // Update loading priorities based on new visible area
-    QVector<int> visibleIndices = getVisibleIndices();
-    
-    // Prioritize loading visible images first
-    for (int index : visibleIndices) {
-        if (index >= 0 && index < m_imageData.size() && !m_nodes.contains(index)) {
-            // Use a short delay to avoid blocking UI during scrolling
-            QTimer::singleShot(10, this, [this, index]() {
-                if (!m_isBeingDestroyed) {
-                    loadImage(index);
-                }
-            });
-        }
-    }
+    // Reorder the load queue around the new visible area
+    scheduleLoadPriorityUpdate();
 }
 
 // Fix the safeCleanup method - ensuring it's complete
@@ -2341,25 +3294,21 @@ void CustomImageListView::safeCleanup()
         delete anim;
     }
 
-    // Handle network cleanup - collect replies first
-    QList<QNetworkReply*> pendingReplies;
-    {
-        QMutexLocker networkLocker(&m_networkMutex);
-        pendingReplies = m_pendingRequests.values();
-        m_pendingRequests.clear();
-    }
-
-    // Process replies outside the lock
-    for (QNetworkReply* reply : pendingReplies) {
-        if (reply) {
-            reply->disconnect();
-            reply->abort();
-            reply->deleteLater();
-        }
+    // Abort downloads in flight and drop queued ones and pending retries
+    if (m_imageFetcher) {
+        m_imageFetcher->cancelAll();
     }
 
     // Clear URL cache to free memory
     m_urlImageCache.clear();
+    
+    // Queued decodes and late results belong to the data being dropped
+    if (m_imageDecoder) {
+        m_imageDecoder->cancelAll();
+    }
+    if (m_loadScheduler) {
+        m_loadScheduler->clear();
+    }
 
     // Add memory barrier before texture operations to ensure 
     // rendering thread isn't accessing textures
@@ -2369,33 +3318,33 @@ void CustomImageListView::safeCleanup()
     {
         QMutexLocker locker(&m_loadMutex);
         
-        // Create a list of nodes to be safely deleted
-        QList<QSGNode*> nodesToDelete;
-        
-        // First collect all nodes to be deleted
-        for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
-            if (it.value().node) {
-                nodesToDelete.append(it.value().node);
-                // Just clear pointer immediately to prevent any further access
-                it.value().node = nullptr;
-            }
-            // Just nullify the texture pointer (window owns the texture)
-            it.value().texture = nullptr;
-        }
-        
-        // Schedule deletion of collected nodes when safe
-        if (win && !nodesToDelete.isEmpty()) {
-            // Schedule a safe batch deletion job
-            win->scheduleRenderJob(new SafeNodeBatchDeleter(nodesToDelete),
+        // Poster nodes are owned by the retained scene graph tree, which the
+        // window tears down with the item; only the texture records go here
+        cleanupTextures();
+        m_posterWaiters.clear();
+        m_waitingPosterKeys.clear();
+        
+        // The poster textures stay with the window's cache for its other
+        // items; the cache frees them on the render thread when the last one
+        // lets go
+        m_textureCache.reset();
+        
+        // Titles and glyph pages no row holds any more are GL textures and
+        // have to go on the render thread; rows release theirs as they die
+        QList<QSGTexture*> atlasPages = m_titleCache->takeUnused();
+        atlasPages += m_glyphAtlas->takePages();
+        if (win && !atlasPages.isEmpty()) {
+            win->scheduleRenderJob(new SafeTextureBatchDeleter(atlasPages),
                                  QQuickWindow::BeforeRenderingStage);
+        } else {
+            qDeleteAll(atlasPages);
         }
-        
-        m_nodes.clear();
     }
     
     // Clear data structures that might be accessed from other methods
     m_imageData.clear();
     m_rowTitles.clear();
+    m_rowItemIndices.clear();
     m_categoryContentX.clear();
     
     // Reset tracking state
@@ -6,6 +6,7 @@
 #include <QUrl>
 #include <QQmlEngine>
 #include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
 #include <QMap>
 #include <QSGGeometryNode>
 #include <QImage>  // Add this include
@@ -13,7 +14,15 @@
 #include <QSGTextureMaterial>
 #include <QSGOpaqueTextureMaterial>
 #include <QSGFlatColorMaterial>
-#include "texturebuffer.h"
+#include "imagelistnodes.h"
+#include "texturecache.h"
+#include "titletexturecache.h"
+#include "glyphatlas.h"
+#include "imagedecoder.h"
+#include "thumbnailcache.h"
+#include "imagememorycache.h"
+#include "imageloadscheduler.h"
+#include "imagefetcher.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
@@ -25,6 +34,7 @@
 #include <QSet>  // Add this include
 #include <QRunnable>  // Add this line to include QRunnable
 #include <QPointer>
+#include <QElapsedTimer>
 
 
 
@@ -46,6 +56,20 @@ class SafeNodeDeleter : public QRunnable {
         QSGNode* m_node;
 };
 
+// Deletes textures on the render thread, where their GL context is current
+class SafeTextureBatchDeleter : public QRunnable {
+    public:
+        explicit SafeTextureBatchDeleter(const QList<QSGTexture*>& textures) : m_textures(textures) {}
+        
+        void run() override {
+            qDeleteAll(m_textures);
+            m_textures.clear();
+        }
+        
+    private:
+        QList<QSGTexture*> m_textures;
+};
+
 // Add this new batch deleter for multiple nodes
 class SafeNodeBatchDeleter : public QRunnable {
     public:
@@ -91,6 +115,32 @@ class CustomImageListView : public QQuickItem
     Q_PROPERTY(int textureCount READ textureCount CONSTANT)  // Simplified read-only property
     Q_PROPERTY(bool enableNodeMetrics READ enableNodeMetrics WRITE setEnableNodeMetrics NOTIFY enableNodeMetricsChanged)
     Q_PROPERTY(bool enableTextureMetrics READ enableTextureMetrics WRITE setEnableTextureMetrics NOTIFY enableTextureMetricsChanged)
+    Q_PROPERTY(qreal overscanMargin READ overscanMargin WRITE setOverscanMargin NOTIFY overscanMarginChanged)
+    Q_PROPERTY(bool mergedRows READ mergedRows WRITE setMergedRows NOTIFY mergedRowsChanged)
+    Q_PROPERTY(bool showPosterTitles READ showPosterTitles WRITE setShowPosterTitles NOTIFY showPosterTitlesChanged)
+    Q_PROPERTY(qreal focusBorderWidth READ focusBorderWidth WRITE setFocusBorderWidth NOTIFY focusBorderWidthChanged)
+    Q_PROPERTY(qreal focusBorderRadius READ focusBorderRadius WRITE setFocusBorderRadius NOTIFY focusBorderRadiusChanged)
+    Q_PROPERTY(int focusAnimationDuration READ focusAnimationDuration WRITE setFocusAnimationDuration NOTIFY focusAnimationDurationChanged)
+    Q_PROPERTY(QString httpCacheDirectory READ httpCacheDirectory WRITE setHttpCacheDirectory NOTIFY httpCacheDirectoryChanged)
+    Q_PROPERTY(qint64 httpCacheSize READ httpCacheSize WRITE setHttpCacheSize NOTIFY httpCacheSizeChanged)
+    Q_PROPERTY(int maxConcurrentDownloads READ maxConcurrentDownloads WRITE setMaxConcurrentDownloads NOTIFY networkSettingsChanged)
+    Q_PROPERTY(int maxDownloadsPerHost READ maxDownloadsPerHost WRITE setMaxDownloadsPerHost NOTIFY networkSettingsChanged)
+    Q_PROPERTY(int networkTimeout READ networkTimeout WRITE setNetworkTimeout NOTIFY networkSettingsChanged)
+    Q_PROPERTY(int downloadRetryCount READ downloadRetryCount WRITE setDownloadRetryCount NOTIFY networkSettingsChanged)
+    Q_PROPERTY(int prefetchDepth READ prefetchDepth WRITE setPrefetchDepth NOTIFY prefetchDepthChanged)
+    Q_PROPERTY(int maxConcurrentLoads READ maxConcurrentLoads WRITE setMaxConcurrentLoads NOTIFY maxConcurrentLoadsChanged)
+    Q_PROPERTY(qint64 urlImageCacheSize READ urlImageCacheSize WRITE setUrlImageCacheSize NOTIFY urlImageCacheSizeChanged)
+    Q_PROPERTY(qint64 urlImageCacheBytes READ urlImageCacheBytes NOTIFY urlImageCacheStatsChanged)
+    Q_PROPERTY(qint64 urlImageCacheHits READ urlImageCacheHits NOTIFY urlImageCacheStatsChanged)
+    Q_PROPERTY(qint64 urlImageCacheMisses READ urlImageCacheMisses NOTIFY urlImageCacheStatsChanged)
+    Q_PROPERTY(qint64 urlImageCacheEvictions READ urlImageCacheEvictions NOTIFY urlImageCacheStatsChanged)
+    Q_PROPERTY(qint64 textureMemoryBudget READ textureMemoryBudget WRITE setTextureMemoryBudget NOTIFY textureMemoryBudgetChanged)
+    Q_PROPERTY(qint64 textureMemoryUsage READ textureMemoryUsage NOTIFY textureMemoryChanged)
+    Q_PROPERTY(qint64 textureMemoryPeak READ textureMemoryPeak NOTIFY textureMemoryChanged)
+    Q_PROPERTY(PosterFormat posterFormat READ posterFormat WRITE setPosterFormat NOTIFY posterFormatChanged)
+    Q_PROPERTY(QVariantMap rowPosterFormats READ rowPosterFormats WRITE setRowPosterFormats NOTIFY posterFormatChanged)
+    Q_PROPERTY(int maxUploadsPerFrame READ maxUploadsPerFrame WRITE setMaxUploadsPerFrame NOTIFY uploadBudgetChanged)
+    Q_PROPERTY(qint64 maxUploadBytesPerFrame READ maxUploadBytesPerFrame WRITE setMaxUploadBytesPerFrame NOTIFY uploadBudgetChanged)
 
 private:
     // Move ImageData struct definition to the top of the private section
@@ -139,6 +189,15 @@ private:
     QMutex m_loadMutex;
     bool m_enableNodeMetrics = false;
     bool m_enableTextureMetrics = false;
+    qreal m_overscanMargin = 100;  // Extra pixels around the viewport that still get nodes
+    bool m_mergedRows = false;  // Draw each row's posters as one geometry per atlas page
+    bool m_showPosterTitles = false;  // Title label over the bottom of each poster
+    qreal m_focusBorderWidth = 2;  // Focus frame stroke in item pixels
+    qreal m_focusBorderRadius = 0;  // Focus frame corner radius
+    int m_focusAnimationDuration = 0;  // Focus zoom-in time in ms, run on the render thread; 0 snaps
+    QString m_httpCacheDirectory;  // HTTP response cache location; empty uses the platform cache dir
+    qint64 m_httpCacheSize = 64 * 1024 * 1024;  // Byte limit of the HTTP response cache
+    QNetworkDiskCache *m_httpCache = nullptr;  // Owned by m_networkManager
 
     // Add new members for UI settings
     int m_titleHeight = 25; // Reduced from 30 to 25
@@ -153,6 +212,23 @@ private:
     QMap<QString, qreal> m_categoryContentX;
     QString m_currentCategory;
     
+    // Item indices of each row in m_rowTitles order, kept in sync with m_imageData
+    QVector<QVector<int>> m_rowItemIndices;
+    QVector<int> m_itemCategories;  // Row of each item index, -1 if uncategorized
+    QVector<int> m_itemColumns;     // Column of each item index within its row
+    void rebuildRowItemIndices();
+
+    // What the next updatePaintNode has to refresh. Layout changes walk the
+    // visible rows; horizontal scrolls, texture arrivals and focus moves
+    // patch only their nodes.
+    bool m_layoutDirty = true;
+    bool m_focusDirty = false;
+    QSet<int> m_scrolledRows;  // Category indices
+    QSet<int> m_dirtyItems;
+    void invalidateLayout();
+    void invalidateItem(int index);
+    void invalidateFocus();
+
     // Add new helper methods
     void setCategoryContentX(const QString& category, qreal x);
     qreal getCategoryContentX(const QString& category) const;
@@ -163,6 +239,7 @@ private:
 
     // Add network manager setup method declaration
     void setupNetworkManager();
+    QString resolvedHttpCacheDirectory() const;
 
     struct CategoryDimensions {
         int rowHeight;
@@ -262,6 +339,13 @@ private:
     void animateVerticalScroll(qreal targetY);
 
 public:
+    // Pixel format posters are uploaded in. The RGB formats drop the alpha
+    // channel, so they are meant for opaque (JPEG) posters; they need 3 or 2
+    // bytes per pixel instead of 4, which is all they save. Poster nodes
+    // never blend, whatever the format.
+    enum PosterFormat { PosterRgba8888, PosterRgb888, PosterRgb565 };
+    Q_ENUM(PosterFormat)
+
     CustomImageListView(QQuickItem *parent = nullptr);
     ~CustomImageListView();
 
@@ -332,6 +416,53 @@ public:
     bool enableTextureMetrics() const { return m_enableTextureMetrics; }
     void setEnableTextureMetrics(bool enable);
 
+    qreal overscanMargin() const { return m_overscanMargin; }
+    void setOverscanMargin(qreal margin);
+    bool mergedRows() const { return m_mergedRows; }
+    void setMergedRows(bool merged);
+    bool showPosterTitles() const { return m_showPosterTitles; }
+    void setShowPosterTitles(bool show);
+    qreal focusBorderWidth() const { return m_focusBorderWidth; }
+    void setFocusBorderWidth(qreal width);
+    qreal focusBorderRadius() const { return m_focusBorderRadius; }
+    void setFocusBorderRadius(qreal radius);
+    int focusAnimationDuration() const { return m_focusAnimationDuration; }
+    void setFocusAnimationDuration(int duration);
+    QString httpCacheDirectory() const { return m_httpCacheDirectory; }
+    void setHttpCacheDirectory(const QString &directory);
+    qint64 httpCacheSize() const { return m_httpCacheSize; }
+    void setHttpCacheSize(qint64 size);
+    int maxConcurrentDownloads() const { return m_imageFetcher->maxActive(); }
+    void setMaxConcurrentDownloads(int count);
+    int maxDownloadsPerHost() const { return m_imageFetcher->maxPerHost(); }
+    void setMaxDownloadsPerHost(int count);
+    int networkTimeout() const { return m_imageFetcher->timeout(); }  // Stall timeout in ms, 0 disables
+    void setNetworkTimeout(int ms);
+    int downloadRetryCount() const { return m_imageFetcher->maxRetries(); }
+    void setDownloadRetryCount(int count);
+    int prefetchDepth() const { return m_prefetchDepth; }
+    void setPrefetchDepth(int depth);
+    int maxConcurrentLoads() const { return m_loadScheduler->maxActive(); }
+    void setMaxConcurrentLoads(int count);
+    qint64 urlImageCacheSize() const { return m_urlImageCache.maxBytes(); }
+    void setUrlImageCacheSize(qint64 size);
+    qint64 urlImageCacheBytes() const { return m_urlImageCache.totalBytes(); }
+    qint64 urlImageCacheHits() const { return qint64(m_urlImageCache.hits()); }
+    qint64 urlImageCacheMisses() const { return qint64(m_urlImageCache.misses()); }
+    qint64 urlImageCacheEvictions() const { return qint64(m_urlImageCache.evictions()); }
+    qint64 textureMemoryBudget() const { return m_textureMemoryBudget; }
+    void setTextureMemoryBudget(qint64 bytes);
+    qint64 textureMemoryUsage() const { return m_textureMemoryUsage; }
+    qint64 textureMemoryPeak() const { return m_textureMemoryPeak; }
+    PosterFormat posterFormat() const { return m_posterFormat; }
+    void setPosterFormat(PosterFormat format);
+    QVariantMap rowPosterFormats() const { return m_rowPosterFormats; }
+    void setRowPosterFormats(const QVariantMap &formats);
+    int maxUploadsPerFrame() const { return m_maxUploadsPerFrame; }
+    void setMaxUploadsPerFrame(int count);
+    qint64 maxUploadBytesPerFrame() const { return m_maxUploadBytesPerFrame; }
+    void setMaxUploadBytesPerFrame(qint64 bytes);
+
     // Add method to update metrics
     void updateMetricCounts(int nodes, int textures) {
         if (m_totalNodeCount != nodes || m_textureCount != textures) {
@@ -368,6 +499,23 @@ signals:
     void assetFocused(const QJsonObject& assetData);  // Modified to pass complete JSON object
     void enableNodeMetricsChanged();
     void enableTextureMetricsChanged();
+    void overscanMarginChanged();
+    void mergedRowsChanged();
+    void showPosterTitlesChanged();
+    void focusBorderWidthChanged();
+    void focusBorderRadiusChanged();
+    void focusAnimationDurationChanged();
+    void httpCacheDirectoryChanged();
+    void httpCacheSizeChanged();
+    void networkSettingsChanged();
+    void prefetchDepthChanged();
+    void maxConcurrentLoadsChanged();
+    void urlImageCacheSizeChanged();
+    void urlImageCacheStatsChanged();
+    void textureMemoryBudgetChanged();
+    void textureMemoryChanged();
+    void posterFormatChanged();
+    void uploadBudgetChanged();
 
 protected:
     QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
@@ -380,13 +528,10 @@ protected:
     void wheelEvent(QWheelEvent *event) override;
 
 private:
-    QMutex m_networkMutex;
-    
     // Add loadAllImages declaration with other loading-related methods
     void loadAllImages();
     QString generateImageUrl(int index) const;
     QImage loadLocalImage(int index) const;
-    QImage loadLocalImageFromPath(const QString &path) const;
     void loadImage(int index);
     void loadUrlImage(int index, const QUrl &url);
     void handleNetworkReply(QNetworkReply *reply, int index);
@@ -402,53 +547,152 @@ private:
     void navigateDown();
     void ensureIndexVisible(int index);
 
-    // Remove static texture cache as TextureBuffer handles it
-
     // Add new members for URL handling
-    QHash<int, QNetworkReply*> m_pendingRequests;
-    QHash<QUrl, QImage> m_urlImageCache;
+    ImageMemoryCache m_urlImageCache;  // Scaled decoded posters by posterKey, LRU within urlImageCacheSize
 
     int getRowFromIndex(int index) const { return index / m_itemsPerRow; }
     int getColumnFromIndex(int index) const { return index % m_itemsPerRow; }
 
-    QSGGeometryNode* createRowTitleNode(const QString &text, const QRectF &rect);
+    TexturedRectNode* createRowTitleNode(const QString &text, const QRectF &rect);
+
+    // Title textures shared by the rows; rows hold a reference so the cache
+    // outlives the view until the scene graph has released the tree
+    QSharedPointer<TitleTextureCache> m_titleCache;
 
     void createFallbackTexture(int index);  // Add this declaration
     bool isReadyForTextures() const;  // Add this declaration
     void cleanupTextures();  // Add this declaration
 
-    // Add TexturedNode structure definition before it's used
+    // Texture loaded for an item index. The poster nodes that display it are
+    // owned by the retained scene graph tree, not by this record. Atlas backed
+    // posters point at their atlas page and sample only sourceRect of it.
     struct TexturedNode {
-        TexturedNode() : node(nullptr), texture(nullptr) {}
-        ~TexturedNode() {
-            delete node;
-            node = nullptr;
-            texture = nullptr;
-        }
-        QSGGeometryNode *node;
+        TexturedNode() : texture(nullptr), sourceRect(0, 0, 1, 1) {}
         QSGTexture *texture;
+        QRectF sourceRect;
     };
 
-    void cleanupNode(TexturedNode& node);
     QMap<int, TexturedNode> m_nodes;
 
-    void limitTextureCacheSize(int maxTextures = 10);
+    // Cache key each index holds a texture reference on; posters are keyed by
+    // image and decoded size (posterKey), so duplicates share one texture
+    QHash<int, QString> m_itemPosterKeys;
+
+    // Indices waiting on an in-flight load of their image, the loading index first
+    QHash<QString, QList<int>> m_posterWaiters;
+    QHash<int, QString> m_waitingPosterKeys;
+
+    // Upload format of the view, overridden per row title by rowPosterFormats
+    PosterFormat m_posterFormat = PosterRgba8888;
+    QVariantMap m_rowPosterFormats;
+    QImage::Format posterImageFormat(int index) const;
+
+    QString posterKey(int index) const;
+    QList<int> takePosterWaiters(int index);
+    bool setItemTexture(int index, const QString &key);
+    void releaseItemTexture(int index);
+
+    // Refcounted textures shared by every view in the window; posters of a
+    // row end up on the same atlas page and batch
+    QSharedPointer<TextureCache> m_textureCache;
+    TextureCache *textureCache();
+    bool insertTexture(const QString &key, const QImage &image);
+
+    // Ceiling on the GPU memory of the window's texture cache. When a poster
+    // does not fit, the textures of the posters furthest off screen are
+    // released first; usage and its high-water mark are what the cache last
+    // reported to this view.
+    qint64 m_textureMemoryBudget = 96 * 1024 * 1024;
+    qint64 m_textureMemoryUsage = 0;
+    qint64 m_textureMemoryPeak = 0;
+    QList<int> coldPosterIndices() const;
+    void releasePoster(int index);
+    void releaseColdTextures();
+    void updateTextureMemoryStats();
+
+    // Finished images waiting for a frame with upload budget, oldest first.
+    // Indices sharing an image ride on one entry; m_queuedUploadKeys says
+    // which indices still want which entry.
+    struct PendingUpload {
+        QString key;
+        QImage image;
+        QList<int> indices;
+    };
+    QList<PendingUpload> m_uploadQueue;
+    QHash<int, QString> m_queuedUploadKeys;
+    int m_maxUploadsPerFrame = 4;
+    qint64 m_maxUploadBytesPerFrame = 2 * 1024 * 1024;
+    void queueUpload(const QString &key, const QImage &image, const QList<int> &indices);
+
+    // Glyphs of the poster labels, touched only during sync
+    GlyphAtlas *m_glyphAtlas = nullptr;
+
+    // Worker pool decoding local images
+    ImageDecoder *m_imageDecoder = nullptr;
+
+    // Texture-ready remote posters kept across launches; written by the
+    // decoder workers, read here before any request goes out
+    ThumbnailCache *m_thumbnailCache = nullptr;
+
+    // Remote downloads with per-host and global limits, timeouts and retries
+    ImageFetcher *m_imageFetcher = nullptr;
+
+    // Orders and caps poster loads; re-prioritized on scroll and focus change
+    ImageLoadScheduler *m_loadScheduler = nullptr;
+    bool m_loadPriorityUpdateScheduled = false;
+
+    // Recent D-pad navigation, which decides what gets prefetched
+    enum NavigationDirection { NavigateNone, NavigateLeft, NavigateRight, NavigateUp, NavigateDown };
+    NavigationDirection m_navigationDirection = NavigateNone;
+    qreal m_navigationInterval = 1000;  // Smoothed ms between presses in one direction
+    QElapsedTimer m_navigationClock;
+    int m_prefetchDepth = 4;  // Posters warmed ahead of the focus at browsing pace
+    void recordNavigation(NavigationDirection direction);
+    QHash<int, qreal> prefetchPriorities() const;
+
+    QVector<qreal> rowPositions() const;
+    void updateLoadPriorities();
+    void scheduleLoadPriorityUpdate();
+    void cancelImageLoad(int index);
+    QSize posterTargetSize(int index) const;
     void safeReleaseTextures();
     bool ensureValidWindow() const;
     
-    static constexpr int MAX_LOADED_TEXTURES = 10;
-
     void loadFromJson(const QUrl &source);
     void processJsonData(const QByteArray &data);
 
     //QVector<ImageData> m_imageData;
 
     // Organize all node creation methods together in one place
-    QSGGeometryNode* createTexturedRect(const QRectF &rect, QSGTexture *texture, bool isFocused = false);
+    TexturedRectNode* createTexturedRect(const QRectF &rect, QSGTexture *texture,
+                                         const QRectF &sourceRect = QRectF(0, 0, 1, 1));
    // QSGGeometryNode* createRowTitleNode(const QString &text, const QRectF &rect);
-    QSGGeometryNode* createOptimizedTextNode(const QString &text, const QRectF &rect);
-    void addSelectionEffects(QSGNode* container, const QRectF& rect);
-    void addTitleOverlay(QSGNode* container, const QRectF& rect, const QString& title);
+
+    // Retained-mode helpers used by updatePaintNode to patch existing nodes
+    void updateAllRows(ImageListRootNode *rootNode);
+    void updateDirtyItems(ImageListRootNode *rootNode);
+    QRectF posterRect(int categoryIndex, int column) const;
+    void updateRowNode(CategoryRowNode *rowNode, int categoryIndex);
+    void scrollRowNode(CategoryRowNode *rowNode, int categoryIndex);
+    void visibleColumns(int categoryIndex, qreal scrollX, int &firstColumn, int &lastColumn) const;
+    void updateRowColumns(CategoryRowNode *rowNode, int categoryIndex, int firstColumn, int lastColumn);
+    void updateMergedRow(CategoryRowNode *rowNode, const QVector<int> &indices,
+                         int firstColumn, int lastColumn, qreal firstItemX,
+                         qreal itemY, qreal stride, const CategoryDimensions &dims);
+    void updateRowTitle(CategoryRowNode *rowNode, const QString &text, const QRectF &rect);
+    void updatePosterItem(PosterItemNode *itemNode, int index, const QRectF &rect);
+    void appendPosterLabel(int index, const QRectF &posterRect, DecorationNode *decorations,
+                           GlyphAtlas::QuadsByTexture &quadsByTexture);
+    void updateLabelNodes(QSGNode *parent, QHash<QSGTexture*, GlyphTextNode*> &textNodes,
+                          const GlyphAtlas::QuadsByTexture &quadsByTexture,
+                          QSGTexture::Filtering filtering = QSGTexture::Nearest);
+    void updateFocusNode(ImageListRootNode *rootNode);
+    void updatePosterItems(CategoryRowNode *rowNode, const QVector<int> &indices,
+                           int firstColumn, int lastColumn, qreal firstItemX,
+                           qreal itemY, qreal stride, const CategoryDimensions &dims);
+    void updatePosterLabels(CategoryRowNode *rowNode, const QVector<int> &indices,
+                            int firstColumn, int lastColumn, qreal firstItemX,
+                            qreal itemY, qreal stride, const CategoryDimensions &dims);
 
     // Add new method declarations
     void loadUISettings();
@@ -458,82 +702,65 @@ private:
     void handleKeyAction(Qt::Key key);  // Add this helper method
 
 private slots:
+    void drainUploadQueue();
+
     // Change these from declarations to actual slot definitions
-    void onNetworkReplyFinished() {
-        QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-        if (!reply) return;
-        
-        int index = -1;
-        
-        // Minimize mutex lock duration - just extract what we need
-        {
-            QMutexLocker locker(&m_networkMutex);
-            index = m_pendingRequests.key(reply, -1);
-            
-            // Remove from pending requests map while under lock
-            if (index != -1) {
-                m_pendingRequests.remove(index);
-            }
-        }
-        
-        // Process the reply outside of mutex lock to avoid deadlocks
-        if (index == -1) {
-            reply->deleteLater();
-            return;
-        }
+    void onImageFetched(int index, const QByteArray &data, const QUrl &url) {
+        if (m_isBeingDestroyed) return;
 
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            if (!data.isEmpty()) {
-                QImage image;
-                if (image.loadFromData(data)) {
-                    m_urlImageCache.insert(reply->url(), image);
-                    processLoadedImage(index, image);
-                } else {
-                    createFallbackTexture(index);
-                }
-            } else {
-                createFallbackTexture(index);
-            }
-        } else {
+        if (data.isEmpty()) {
             createFallbackTexture(index);
+            return;
         }
 
-        reply->deleteLater();
+        // Decode on the decoder's pool; the bytes are shared, not copied,
+        // and the image comes back in a batch through onImagesDecoded()
+        m_imageDecoder->decodeData(index, data, posterTargetSize(index), url, posterImageFormat(index));
     }
 
-    void onNetworkError(QNetworkReply::NetworkError code) {
-        QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-        if (!reply) return;
-        
-        int index = -1;
-        
-        // Minimize mutex lock duration
-        {
-            QMutexLocker locker(&m_networkMutex);
-            index = m_pendingRequests.key(reply, -1);
-            if (index != -1) {
-                m_pendingRequests.remove(index);
-            }
+    void onImageFetchFailed(int index, const QString &error) {
+        Q_UNUSED(error)
+        if (m_isBeingDestroyed) return;
+        createFallbackTexture(index);
+    }
+
+    void onLoadRequested(int index) {
+        if (m_isBeingDestroyed || !isReadyForTextures()) {
+            m_loadScheduler->finish(index);
+            return;
         }
-        
-        // Process outside the lock
-        if (index != -1) {
-            createFallbackTexture(index);
+
+        loadImage(index);
+
+        // Cache hits complete synchronously; everything else finishes when
+        // the image or its fallback arrives
+        if (!m_imageDecoder->isPending(index) && !m_imageFetcher->isPending(index)) {
+            m_loadScheduler->finish(index);
         }
     }
 
-    void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal) {
-        QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-        if (!reply) return;
+    void onLoadCancelled(int index) {
+        cancelImageLoad(index);
+    }
 
-        int index = m_pendingRequests.key(reply, -1);
-        if (index != -1) {
-            qDebug() << "Download progress for index" << index << ":"
-                     << bytesReceived << "/" << bytesTotal << "bytes";
+    void onImagesDecoded(const QVector<ImageDecoder::Result> &results) {
+        if (m_isBeingDestroyed) return;
+
+        for (const ImageDecoder::Result &result : results) {
+            if (result.image.isNull()) {
+                createFallbackTexture(result.index);
+                continue;
+            }
+            // Cached under the key it was prepared for; a format changed
+            // while decoding leaves it out
+            if (result.source.isValid() && result.image.format() == posterImageFormat(result.index)) {
+                m_urlImageCache.insert(posterKey(result.index), result.image);
+                emit urlImageCacheStatsChanged();
+            }
+            processLoadedImage(result.index, result.image);
         }
     }
-    
+
     void onScrollAnimationValueChanged(const QVariant &value) {
         QPropertyAnimation* anim = qobject_cast<QPropertyAnimation*>(sender());
         if (!anim) return;
@@ -0,0 +1,49 @@
+import json
+import os
+import sys
+
+# Builds a large hub menu in the same shape as data/embeddedHubMenu.json so the
+# viewport culling in CustomImageListView can be checked: point jsonSource at
+# the generated file, enable node metrics (N key) and the nodeCount reported by
+# the metrics overlay stays bounded by the screen size, not by ROWS * ITEMS.
+
+ROWS = 50
+ITEMS_PER_ROW = 40
+
+def create_item(row, column):
+    image_index = (row * ITEMS_PER_ROW + column) % 5 + 1
+    return {
+        "assetType": "vod",
+        "title": f"Row {row + 1} Item {column + 1}",
+        "shortSynopsis": f"Benchmark item {column + 1} in row {row + 1}",
+        "moodImageUri": f":/data/images/img{image_index}.jpg",
+        "thumbnailUri": "",
+        "links": []
+    }
+
+def create_catalog(rows, items_per_row):
+    return {
+        "menuItems": {
+            "type": "menu",
+            "total": rows,
+            "focusedItemIndex": 0,
+            "items": [
+                {
+                    "title": f"Benchmark Row {row + 1}",
+                    "classificationId": f"Benchmark:{row + 1}",
+                    "type": "assetList",
+                    "count": items_per_row,
+                    "items": [create_item(row, column) for column in range(items_per_row)]
+                }
+                for row in range(rows)
+            ]
+        }
+    }
+
+output = sys.argv[1] if len(sys.argv) > 1 else 'data/benchmarkHubMenu.json'
+os.makedirs(os.path.dirname(output) or '.', exist_ok=True)
+
+with open(output, 'w') as f:
+    json.dump(create_catalog(ROWS, ITEMS_PER_ROW), f, indent=2)
+
+print(f"Created {output} with {ROWS} rows of {ITEMS_PER_ROW} items")
@@ -0,0 +1,159 @@
+#include "glyphatlas.h"
+#include <QFontMetricsF>
+#include <QGlyphRun>
+#include <QTextLayout>
+#include <QtMath>
+
+uint qHash(const GlyphAtlas::GlyphKey &key, uint seed)
+{
+    return qHash(key.fontKey, seed) ^ key.glyphIndex ^ key.color;
+}
+
+GlyphAtlas::GlyphAtlas(const QSize &pageSize, int maxPages)
+    : m_atlas(pageSize)
+    , m_maxPages(maxPages)
+    , m_shapedTexts(4096)
+{
+}
+
+void GlyphAtlas::appendText(const QString &text, const QFont &font, const QColor &color,
+                            const QRectF &rect, QuadsByTexture &quads)
+{
+    const ShapedText *shaped = shapeText(text, font, rect.width());
+    if (!shaped || shaped->glyphs.isEmpty()) {
+        return;
+    }
+
+    // Center the run and snap the baseline to whole pixels so glyphs map 1:1
+    QPointF origin(qRound(rect.center().x() - shaped->width / 2),
+                   qRound(rect.center().y() + (shaped->ascent - shaped->descent) / 2));
+
+    for (const PositionedGlyph &positioned : shaped->glyphs) {
+        const CachedGlyph &cached = glyph(positioned.rawFont, positioned.glyphIndex, color);
+        if (cached.region.isNull()) {
+            continue;
+        }
+
+        QPointF topLeft(qRound(origin.x() + positioned.position.x()) + cached.offset.x(),
+                        qRound(origin.y() + positioned.position.y()) + cached.offset.y());
+
+        QSize pageSize = cached.region.page->textureSize();
+        const QRect &r = cached.region.rect;
+
+        QuadBatchNode::Quad quad;
+        quad.rect = QRectF(topLeft, QSizeF(r.size()));
+        quad.sourceRect = QRectF(qreal(r.x()) / pageSize.width(), qreal(r.y()) / pageSize.height(),
+                                 qreal(r.width()) / pageSize.width(), qreal(r.height()) / pageSize.height());
+        quads[cached.region.page].append(quad);
+    }
+}
+
+QList<QSGTexture*> GlyphAtlas::takePages()
+{
+    m_glyphs.clear();
+    m_full = false;
+    return m_atlas.takePages();
+}
+
+const GlyphAtlas::ShapedText *GlyphAtlas::shapeText(const QString &text, const QFont &font, qreal maxWidth)
+{
+    QString cacheKey = font.key() + QLatin1Char('|') + QString::number(qFloor(maxWidth))
+                     + QLatin1Char('|') + text;
+    if (ShapedText *shaped = m_shapedTexts.object(cacheKey)) {
+        return shaped;
+    }
+
+    QFontMetricsF fm(font);
+    QString elided = fm.elidedText(text, Qt::ElideRight, maxWidth);
+
+    QTextLayout layout(elided, font);
+    layout.setCacheEnabled(true);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    layout.endLayout();
+
+    ShapedText *shaped = new ShapedText;
+    shaped->width = line.isValid() ? line.naturalTextWidth() : 0;
+    shaped->ascent = fm.ascent();
+    shaped->descent = fm.descent();
+
+    // Positions come out relative to the line's top; move them to the baseline
+    qreal baseline = line.isValid() ? line.ascent() : fm.ascent();
+    const QList<QGlyphRun> runs = layout.glyphRuns();
+    for (const QGlyphRun &run : runs) {
+        QRawFont rawFont = run.rawFont();
+        const QVector<quint32> indexes = run.glyphIndexes();
+        const QVector<QPointF> positions = run.positions();
+
+        for (int i = 0; i < indexes.size() && i < positions.size(); ++i) {
+            PositionedGlyph positioned;
+            positioned.rawFont = rawFont;
+            positioned.glyphIndex = indexes[i];
+            positioned.position = positions[i] - QPointF(0, baseline);
+            shaped->glyphs.append(positioned);
+        }
+    }
+
+    m_shapedTexts.insert(cacheKey, shaped);
+    return shaped;
+}
+
+const GlyphAtlas::CachedGlyph &GlyphAtlas::glyph(const QRawFont &rawFont, quint32 glyphIndex, const QColor &color)
+{
+    GlyphKey key;
+    key.fontKey = rawFontKey(rawFont);
+    key.glyphIndex = glyphIndex;
+    key.color = color.rgba();
+
+    auto it = m_glyphs.find(key);
+    if (it != m_glyphs.end()) {
+        return it.value();
+    }
+
+    CachedGlyph cached;
+    QImage coverage = rawFont.alphaMapForGlyph(glyphIndex, QRawFont::PixelAntialiasing);
+
+    if (!coverage.isNull() && !coverage.size().isEmpty()) {
+        // Premultiplied glyph in the label colour, with a transparent 1px
+        // border so neighbouring glyphs never bleed in
+        QImage image(coverage.width() + 2, coverage.height() + 2, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        bool alphaFormat = coverage.format() == QImage::Format_Alpha8;
+        for (int y = 0; y < coverage.height(); ++y) {
+            QRgb *dst = reinterpret_cast<QRgb*>(image.scanLine(y + 1)) + 1;
+            for (int x = 0; x < coverage.width(); ++x) {
+                QRgb px = coverage.pixel(x, y);
+                int a = (alphaFormat ? qAlpha(px) : qGray(px)) * color.alpha() / 255;
+                dst[x] = qRgba(color.red() * a / 255, color.green() * a / 255,
+                               color.blue() * a / 255, a);
+            }
+        }
+
+        cached.region = m_atlas.insert(image);
+
+        // Only a glyph larger than a page fails; leave it out of the cache
+        // rather than remembering the failure
+        if (cached.region.isNull()) {
+            return m_missingGlyph;
+        }
+
+        // The glyph is usable this frame even on a page past the cap; the
+        // owner resets the atlas once the frame is done
+        if (m_atlas.pageCount() > m_maxPages) {
+            m_full = true;
+        }
+
+        QRectF bounds = rawFont.boundingRect(glyphIndex);
+        cached.offset = QPoint(qFloor(bounds.left()) - 1, qFloor(bounds.top()) - 1);
+    }
+
+    return m_glyphs.insert(key, cached).value();
+}
+
+QString GlyphAtlas::rawFontKey(const QRawFont &rawFont)
+{
+    return rawFont.familyName() + QLatin1Char('|') + QString::number(rawFont.pixelSize())
+         + QLatin1Char('|') + QString::number(rawFont.weight())
+         + QLatin1Char('|') + QString::number(int(rawFont.style()));
+}
@@ -0,0 +1,94 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include "textureatlas.h"
+#include "imagelistnodes.h"
+#include <QCache>
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QRawFont>
+
+// Shared glyph cache for poster labels.
+//
+// Strings are shaped once with QTextLayout and the resulting glyph runs are
+// kept per (text, font, width). Each glyph is rasterized once per font, size
+// and colour through QRawFont into a TextureAtlas page, so label cost grows
+// with the number of unique glyphs rather than unique strings. Labels come
+// out as quads grouped by atlas page, ready for a GlyphTextNode.
+//
+// The atlas is capped at maxPages pages. Glyphs are never evicted one by
+// one; once a glyph needs a page past the cap the atlas reports isFull(), and
+// the owner starts over with takePages() once the frame is laid out, redoing the
+// labels it still shows against the emptied atlas.
+//
+// Used from updatePaintNode only, i.e. on the render thread with the GUI
+// thread blocked; pages have to be deleted on the render thread as well.
+class GlyphAtlas
+{
+public:
+    typedef QHash<QSGTexture*, QVector<QuadBatchNode::Quad>> QuadsByTexture;
+
+    explicit GlyphAtlas(const QSize &pageSize = QSize(1024, 1024), int maxPages = 4);
+
+    // Lays out text elided to rect's width and centered in it, appending one
+    // quad per visible glyph to the page it lives on
+    void appendText(const QString &text, const QFont &font, const QColor &color,
+                    const QRectF &rect, QuadsByTexture &quads);
+
+    void commitUploads() { m_atlas.commitUploads(); }
+
+    // Empties the atlas and hands out its pages for deletion once no label
+    // node uses them any more
+    QList<QSGTexture*> takePages();
+
+    // True once the glyphs in use outgrew maxPages pages
+    bool isFull() const { return m_full; }
+
+    int glyphCount() const { return m_glyphs.size(); }
+
+private:
+    struct PositionedGlyph {
+        QRawFont rawFont;
+        quint32 glyphIndex;
+        QPointF position;  // Relative to the start of the baseline
+    };
+
+    struct ShapedText {
+        QVector<PositionedGlyph> glyphs;
+        qreal width;
+        qreal ascent;
+        qreal descent;
+    };
+
+    struct GlyphKey {
+        QString fontKey;
+        quint32 glyphIndex;
+        QRgb color;
+
+        bool operator==(const GlyphKey &other) const
+        {
+            return glyphIndex == other.glyphIndex && color == other.color
+                && fontKey == other.fontKey;
+        }
+    };
+    friend uint qHash(const GlyphKey &key, uint seed);
+
+    struct CachedGlyph {
+        AtlasRegion region;   // Null for blank glyphs such as spaces
+        QPoint offset;        // Image origin relative to the glyph position
+    };
+
+    const ShapedText *shapeText(const QString &text, const QFont &font, qreal maxWidth);
+    const CachedGlyph &glyph(const QRawFont &rawFont, quint32 glyphIndex, const QColor &color);
+    static QString rawFontKey(const QRawFont &rawFont);
+
+    TextureAtlas m_atlas;
+    int m_maxPages;
+    bool m_full = false;
+    QHash<GlyphKey, CachedGlyph> m_glyphs;
+    CachedGlyph m_missingGlyph;  // Returned, uncached, when a glyph does not fit
+    QCache<QString, ShapedText> m_shapedTexts;
+};
+
+#endif // GLYPHATLAS_H
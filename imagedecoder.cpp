@@ -0,0 +1,240 @@
+#include "imagedecoder.h"
+#include "thumbnailcache.h"
+#include <QImageReader>
+#include <QBuffer>
+#include <QRunnable>
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+
+namespace {
+
+// Decodes either a file or an in-memory copy of encoded bytes
+class DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(ImageDecoder *decoder, int index, const QSize &targetSize, QImage::Format format,
+               int requestId, const QSharedPointer<QAtomicInt> &cancelled)
+        : m_decoder(decoder), m_index(index), m_targetSize(targetSize), m_format(format)
+        , m_requestId(requestId), m_cancelled(cancelled) {}
+
+    QString path;
+    QByteArray data;
+    QUrl source;
+    ThumbnailCache *thumbnailCache = nullptr;
+
+    void run() override
+    {
+        // Withdrawn while waiting in the pool, e.g. scrolled far away
+        if (m_cancelled->load()) {
+            return;
+        }
+
+        QImage image;
+        if (!path.isEmpty()) {
+            QImageReader reader(path);
+            image = read(reader, path);
+        } else {
+            // QBuffer shares data's storage, the bytes are never copied
+            QBuffer buffer;
+            buffer.setData(data);
+            buffer.open(QIODevice::ReadOnly);
+            QImageReader reader(&buffer);
+            image = read(reader, source.toString());
+            buffer.close();
+            data.clear();  // Drop our reference before the result is posted
+
+            // Next launch maps these pixels instead of downloading again
+            if (!image.isNull() && thumbnailCache) {
+                thumbnailCache->store(source, m_targetSize, image);
+            }
+        }
+
+        // The decoder waits for its pool on destruction, so it is still alive
+        QMetaObject::invokeMethod(m_decoder, "onWorkerFinished", Qt::QueuedConnection,
+                                  Q_ARG(int, m_index), Q_ARG(QImage, image),
+                                  Q_ARG(QUrl, source), Q_ARG(int, m_requestId));
+    }
+
+private:
+    QImage read(QImageReader &reader, const QString &name) const
+    {
+        reader.setDecideFormatFromContent(true);
+        ImageDecoder::setDecodeSize(reader, m_targetSize);
+
+        QImage image = reader.read();
+        if (!image.isNull()) {
+            image = ImageDecoder::prepareForTexture(image, m_targetSize, m_format);
+        } else {
+            qDebug() << "Failed to decode image from:" << name << reader.errorString();
+        }
+        return image;
+    }
+
+    ImageDecoder *m_decoder;
+    int m_index;
+    QSize m_targetSize;
+    QImage::Format m_format;
+    int m_requestId;
+    QSharedPointer<QAtomicInt> m_cancelled;
+};
+
+} // namespace
+
+ImageDecoder::ImageDecoder(QObject *parent)
+    : QObject(parent)
+{
+    // Leave a core for the GUI and render threads
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 4));
+}
+
+ImageDecoder::~ImageDecoder()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+void ImageDecoder::decodeFile(int index, const QString &path, const QSize &targetSize,
+                              QImage::Format format)
+{
+    if (m_pending.contains(index)) {
+        return;
+    }
+    Request request = newRequest();
+    m_pending.insert(index, request);
+
+    DecodeTask *task = new DecodeTask(this, index, targetSize, format, request.id, request.cancelled);
+    task->path = path;
+    m_pool.start(task);
+}
+
+void ImageDecoder::decodeData(int index, const QByteArray &data, const QSize &targetSize,
+                              const QUrl &source, QImage::Format format)
+{
+    if (m_pending.contains(index)) {
+        return;
+    }
+    Request request = newRequest();
+    m_pending.insert(index, request);
+
+    DecodeTask *task = new DecodeTask(this, index, targetSize, format, request.id, request.cancelled);
+    task->data = data;
+    task->source = source;
+    task->thumbnailCache = m_thumbnailCache;
+    m_pool.start(task);
+}
+
+ImageDecoder::Request ImageDecoder::newRequest()
+{
+    Request request;
+    request.id = ++m_nextRequestId;
+    request.cancelled = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+    return request;
+}
+
+void ImageDecoder::cancel(int index)
+{
+    auto it = m_pending.find(index);
+    if (it != m_pending.end()) {
+        it.value().cancelled->store(1);
+        m_pending.erase(it);
+    }
+
+    for (int i = m_finished.size() - 1; i >= 0; --i) {
+        if (m_finished[i].index == index) {
+            m_finished.remove(i);
+        }
+    }
+}
+
+void ImageDecoder::cancelAll()
+{
+    m_pool.clear();
+    for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+        it.value().cancelled->store(1);
+    }
+    m_pending.clear();
+    m_finished.clear();
+}
+
+QImage ImageDecoder::prepareForTexture(const QImage &image, const QSize &targetSize,
+                                       QImage::Format format)
+{
+    if (image.isNull()) {
+        return image;
+    }
+
+    // Scale maintaining aspect ratio. Smooth scaling works in 32 bits, so it
+    // goes first and the conversion below decides the final format.
+    QImage prepared = image;
+    if (targetSize.isValid() && !targetSize.isEmpty()) {
+        prepared = prepared.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    // In the atlas format already, so no further conversion happens on the
+    // GUI or render thread
+    if (prepared.format() != format) {
+        prepared = prepared.convertToFormat(format);
+    }
+    return prepared;
+}
+
+void ImageDecoder::setDecodeSize(QImageReader &reader, const QSize &targetSize)
+{
+    QSize sourceSize = reader.size();
+    if (!sourceSize.isValid() || !targetSize.isValid() || targetSize.isEmpty()) {
+        return;
+    }
+
+    // Only ever shrink; JPEG then decodes at 1/2, 1/4 or 1/8 scale in the DCT
+    // domain instead of producing the full image first
+    QSize fitted = sourceSize.scaled(targetSize, Qt::KeepAspectRatio);
+    if (fitted.width() < sourceSize.width() && fitted.height() < sourceSize.height()) {
+        reader.setScaledSize(fitted);
+    }
+}
+
+void ImageDecoder::onWorkerFinished(int index, const QImage &image, const QUrl &source,
+                                    int requestId)
+{
+    auto it = m_pending.find(index);
+    if (it == m_pending.end() || it.value().id != requestId) {
+        return;  // Cancelled, or decoded for data that has been replaced since
+    }
+    m_pending.erase(it);
+
+    Result result;
+    result.index = index;
+    result.image = image;
+    result.source = source;
+    m_finished.append(result);
+
+    // Results posted by other workers in the meantime join the same batch
+    if (!m_deliveryScheduled) {
+        m_deliveryScheduled = true;
+        QTimer::singleShot(0, this, SLOT(deliverResults()));
+    }
+}
+
+void ImageDecoder::deliverResults()
+{
+    m_deliveryScheduled = false;
+    if (m_finished.isEmpty()) {
+        return;
+    }
+
+    QVector<Result> batch;
+    if (m_finished.size() <= m_maxBatchSize) {
+        batch.swap(m_finished);
+    } else {
+        batch = m_finished.mid(0, m_maxBatchSize);
+        m_finished.remove(0, m_maxBatchSize);
+
+        // Let pending input through before the next slice
+        m_deliveryScheduled = true;
+        QTimer::singleShot(0, this, SLOT(deliverResults()));
+    }
+
+    emit imagesDecoded(batch);
+}
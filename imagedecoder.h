@@ -0,0 +1,109 @@
+#ifndef IMAGEDECODER_H
+#define IMAGEDECODER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QUrl>
+#include <QVector>
+
+class QImageReader;
+class ThumbnailCache;
+
+// Decodes poster images off the GUI thread.
+//
+// Each request runs on a private QThreadPool: the file or downloaded bytes are
+// decoded straight to roughly the poster size with QImageReader's scaled
+// decoding, brought into texture-ready form (scaled to fit, in the upload
+// format the request asks for) there, and only the finished QImage goes back
+// to the GUI thread, where the view just creates the texture.
+//
+// Finished images are handed out in batches through imagesDecoded(), at most
+// maxBatchSize per event loop pass. A burst of completed downloads therefore
+// turns into a few short slices of texture work with input events processed
+// in between, rather than one long stall.
+//
+// Images decoded from downloaded bytes are also written to the thumbnail
+// cache, when one is set, on the worker that decoded them.
+//
+// cancel() withdraws a single item: a decode that has not started is skipped
+// and a late result is dropped. cancelAll() does the same for everything, so
+// results that arrive after a data reload are ignored. The destructor waits
+// for running workers, which therefore never outlive the decoder.
+class ImageDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageDecoder(QObject *parent = nullptr);
+    ~ImageDecoder();
+
+    // Queues a decode of the image file at path, for item index. targetSize
+    // is the poster slot the image is shown in, format the upload format
+    // (premultiplied RGBA, or RGB888 / RGB16 for opaque posters).
+    void decodeFile(int index, const QString &path, const QSize &targetSize,
+                    QImage::Format format = QImage::Format_RGBA8888_Premultiplied);
+
+    // Queues a decode of encoded image bytes, e.g. a network reply body. The
+    // data is implicitly shared, so handing it over does not copy it; source
+    // is passed back with the result.
+    void decodeData(int index, const QByteArray &data, const QSize &targetSize,
+                    const QUrl &source = QUrl(),
+                    QImage::Format format = QImage::Format_RGBA8888_Premultiplied);
+
+    bool isPending(int index) const { return m_pending.contains(index); }
+    int pendingCount() const { return m_pending.size(); }
+
+    void cancel(int index);
+    void cancelAll();
+
+    // Converts and scales a decoded image the way the worker does; cheap when
+    // the image is already in that form
+    static QImage prepareForTexture(const QImage &image, const QSize &targetSize,
+                                    QImage::Format format = QImage::Format_RGBA8888_Premultiplied);
+
+    // Asks the reader to decode at the largest size that still fits targetSize
+    static void setDecodeSize(QImageReader &reader, const QSize &targetSize);
+
+    struct Result {
+        int index;
+        QImage image;  // Null when decoding failed
+        QUrl source;
+    };
+
+    void setThumbnailCache(ThumbnailCache *cache) { m_thumbnailCache = cache; }
+
+    void setMaxBatchSize(int size) { m_maxBatchSize = qMax(1, size); }
+    int maxBatchSize() const { return m_maxBatchSize; }
+
+signals:
+    void imagesDecoded(const QVector<ImageDecoder::Result> &results);
+
+private slots:
+    void onWorkerFinished(int index, const QImage &image, const QUrl &source, int requestId);
+    void deliverResults();
+
+private:
+    struct Request {
+        int id;
+        QSharedPointer<QAtomicInt> cancelled;  // Shared with the worker task
+    };
+
+    Request newRequest();
+
+    QThreadPool m_pool;
+    ThumbnailCache *m_thumbnailCache = nullptr;
+    QHash<int, Request> m_pending;
+    QVector<Result> m_finished;
+    int m_maxBatchSize = 8;
+    bool m_deliveryScheduled = false;
+    int m_nextRequestId = 0;
+};
+
+#endif // IMAGEDECODER_H
@@ -0,0 +1,251 @@
+#include "imagefetcher.h"
+#include <QNetworkAccessManager>
+#include <QTimer>
+#include <QVector>
+#include <QPair>
+#include <QDebug>
+#include <algorithm>
+
+ImageFetcher::ImageFetcher(QNetworkAccessManager *manager, QObject *parent)
+    : QObject(parent)
+    , m_manager(manager)
+{
+    m_clock.start();
+
+    m_startTimer = new QTimer(this);
+    m_startTimer->setSingleShot(true);
+    connect(m_startTimer, SIGNAL(timeout()), this, SLOT(startQueued()));
+}
+
+ImageFetcher::~ImageFetcher()
+{
+    cancelAll();
+}
+
+void ImageFetcher::fetch(int index, const QNetworkRequest &request)
+{
+    cancel(index);
+
+    Job job;
+    job.request = request;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+    // Negotiated through ALPN; servers without HTTP/2 keep using HTTP/1.1
+    job.request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+    job.sequence = m_nextSequence++;
+    m_jobs.insert(index, job);
+
+    scheduleStart();
+}
+
+void ImageFetcher::cancel(int index)
+{
+    auto it = m_jobs.find(index);
+    if (it == m_jobs.end()) {
+        return;
+    }
+    Job job = it.value();
+    m_jobs.erase(it);
+
+    if (job.reply) {
+        QNetworkReply *reply = job.reply;
+        release(job);
+        reply->abort();
+        reply->deleteLater();
+        scheduleStart();
+    }
+}
+
+void ImageFetcher::cancelAll()
+{
+    const QList<int> indices = m_jobs.keys();
+    for (int index : indices) {
+        cancel(index);
+    }
+}
+
+void ImageFetcher::setMaxActive(int count)
+{
+    m_maxActive = qMax(1, count);
+    scheduleStart();
+}
+
+void ImageFetcher::setMaxPerHost(int count)
+{
+    m_maxPerHost = qMax(1, count);
+    scheduleStart();
+}
+
+QString ImageFetcher::hostKey(const QUrl &url)
+{
+    return url.host() + QLatin1Char(':') + QString::number(url.port(url.scheme() == QLatin1String("https") ? 443 : 80));
+}
+
+void ImageFetcher::scheduleStart(int delayMs)
+{
+    // Keep the earliest pending start
+    if (m_startTimer->isActive() && m_startTimer->remainingTime() <= delayMs) {
+        return;
+    }
+    m_startTimer->start(delayMs);
+}
+
+void ImageFetcher::startQueued()
+{
+    qint64 now = m_clock.elapsed();
+    qint64 nextRetry = -1;
+
+    // Oldest first; only jobs whose backoff has passed are eligible
+    QVector<QPair<qint64, int> > waiting;
+    for (auto it = m_jobs.constBegin(); it != m_jobs.constEnd(); ++it) {
+        const Job &job = it.value();
+        if (job.reply) {
+            continue;
+        }
+        if (job.notBefore > now) {
+            nextRetry = nextRetry < 0 ? job.notBefore : qMin(nextRetry, job.notBefore);
+            continue;
+        }
+        waiting.append(qMakePair(job.sequence, it.key()));
+    }
+    std::sort(waiting.begin(), waiting.end());
+
+    for (const QPair<qint64, int> &entry : waiting) {
+        if (m_activeCount >= m_maxActive) {
+            break;
+        }
+        Job &job = m_jobs[entry.second];
+        if (m_activePerHost.value(hostKey(job.request.url())) >= m_maxPerHost) {
+            continue;  // Another host may still have room
+        }
+        start(entry.second, job);
+    }
+
+    if (nextRetry >= 0) {
+        scheduleStart(int(nextRetry - now));
+    }
+}
+
+void ImageFetcher::start(int index, Job &job)
+{
+    job.timedOut = false;
+    job.reply = m_manager->get(job.request);
+    m_replyIndex.insert(job.reply, index);
+    ++m_activePerHost[hostKey(job.request.url())];
+    ++m_activeCount;
+
+    connect(job.reply, SIGNAL(finished()), this, SLOT(onReplyFinished()));
+    connect(job.reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(onReplyProgress()));
+    connect(job.reply, SIGNAL(sslErrors(QList<QSslError>)), job.reply, SLOT(ignoreSslErrors()));
+
+    if (m_timeoutMs > 0) {
+        // Restarted on every chunk, so only a stalled transfer times out
+        job.timer = new QTimer(job.reply);
+        job.timer->setSingleShot(true);
+        connect(job.timer, SIGNAL(timeout()), this, SLOT(onReplyTimeout()));
+        job.timer->start(m_timeoutMs);
+    }
+}
+
+// Forgets the job's reply and frees its slots; the caller disposes of the reply
+void ImageFetcher::release(Job &job)
+{
+    if (!job.reply) {
+        return;
+    }
+    job.reply->disconnect(this);
+    if (job.timer) {
+        job.timer->stop();
+        job.timer = nullptr;  // Owned by the reply
+    }
+    m_replyIndex.remove(job.reply);
+
+    QString host = hostKey(job.request.url());
+    if (--m_activePerHost[host] <= 0) {
+        m_activePerHost.remove(host);
+    }
+    --m_activeCount;
+    job.reply = nullptr;
+}
+
+void ImageFetcher::onReplyProgress()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    int index = m_replyIndex.value(reply, -1);
+    if (index != -1 && m_jobs[index].timer) {
+        m_jobs[index].timer->start(m_timeoutMs);
+    }
+}
+
+void ImageFetcher::onReplyTimeout()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender()->parent());
+    int index = m_replyIndex.value(reply, -1);
+    if (index != -1) {
+        m_jobs[index].timedOut = true;
+        reply->abort();  // Finishes the reply, which decides about the retry
+    }
+}
+
+bool ImageFetcher::shouldRetry(const Job &job, QNetworkReply *reply) const
+{
+    if (job.attempt >= m_maxRetries) {
+        return false;
+    }
+    if (job.timedOut) {
+        return true;
+    }
+
+    switch (reply->error()) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+        return true;
+    default:
+        break;
+    }
+
+    int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    return status == 429 || status >= 500;
+}
+
+void ImageFetcher::onReplyFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    int index = m_replyIndex.value(reply, -1);
+    if (index == -1) {
+        return;
+    }
+
+    Job &job = m_jobs[index];
+    bool retry = reply->error() != QNetworkReply::NoError && shouldRetry(job, reply);
+    release(job);
+    reply->deleteLater();  // Hands the connection back to the manager's pool
+
+    if (retry) {
+        // 1x, 2x, 4x ... the base delay, with some jitter so a batch that
+        // failed together does not come back together
+        int delay = m_retryDelayMs << job.attempt;
+        delay += delay > 0 ? qrand() % (delay / 2 + 1) : 0;
+        ++job.attempt;
+        job.notBefore = m_clock.elapsed() + delay;
+        qDebug() << "Retrying" << job.request.url().toString() << "in" << delay << "ms, attempt" << job.attempt;
+        scheduleStart();
+        return;
+    }
+
+    Job finished = m_jobs.take(index);
+    scheduleStart();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        if (reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+            qDebug() << "Served from HTTP cache:" << finished.request.url().toString();
+        }
+        emit fetched(index, reply->readAll(), finished.request.url());
+    } else {
+        QString error = finished.timedOut ? QStringLiteral("Timed out") : reply->errorString();
+        qDebug() << "Fetch failed for" << finished.request.url().toString() << ":" << error;
+        emit fetchFailed(index, error);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef IMAGEFETCHER_H
+#define IMAGEFETCHER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QTimer;
+
+// Downloads poster images through a shared QNetworkAccessManager with
+// bounded concurrency.
+//
+// Requests are started in the order they were queued, at most maxActive at a
+// time and at most maxPerHost against one host. Staying under the manager's
+// own per-host connection pool means a request always goes out on a kept-alive
+// connection instead of waiting inside the manager, and the earliest queued
+// (i.e. most urgent) posters are never stuck behind a burst. HTTP/2 is
+// allowed where the Qt version supports it, so a capable server multiplexes
+// everything over one connection.
+//
+// A request that sees no data for timeoutMs is aborted. Timeouts, dropped
+// connections and 429 / 5xx answers are retried up to maxRetries times with
+// exponential backoff starting at retryDelayMs.
+class ImageFetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageFetcher(QNetworkAccessManager *manager, QObject *parent = nullptr);
+    ~ImageFetcher();
+
+    // Queues a download for item index, replacing any earlier one for it
+    void fetch(int index, const QNetworkRequest &request);
+    void cancel(int index);
+    void cancelAll();
+
+    bool isPending(int index) const { return m_jobs.contains(index); }
+    int activeCount() const { return m_activeCount; }
+
+    void setMaxActive(int count);
+    int maxActive() const { return m_maxActive; }
+    void setMaxPerHost(int count);
+    int maxPerHost() const { return m_maxPerHost; }
+    void setTimeout(int ms) { m_timeoutMs = qMax(0, ms); }
+    int timeout() const { return m_timeoutMs; }
+    void setMaxRetries(int count) { m_maxRetries = qMax(0, count); }
+    int maxRetries() const { return m_maxRetries; }
+    void setRetryDelay(int ms) { m_retryDelayMs = qMax(0, ms); }
+    int retryDelay() const { return m_retryDelayMs; }
+
+signals:
+    void fetched(int index, const QByteArray &data, const QUrl &url);
+    void fetchFailed(int index, const QString &error);
+
+private slots:
+    void onReplyFinished();
+    void onReplyProgress();
+    void onReplyTimeout();
+    void startQueued();
+
+private:
+    struct Job {
+        QNetworkRequest request;
+        QNetworkReply *reply = nullptr;
+        QTimer *timer = nullptr;
+        int attempt = 0;
+        qint64 notBefore = 0;  // Clock time a retry may start at
+        qint64 sequence = 0;   // Queue order
+        bool timedOut = false;
+    };
+
+    static QString hostKey(const QUrl &url);
+    bool shouldRetry(const Job &job, QNetworkReply *reply) const;
+    void start(int index, Job &job);
+    void release(Job &job);
+    void scheduleStart(int delayMs = 0);
+
+    QNetworkAccessManager *m_manager;
+    QHash<int, Job> m_jobs;
+    QHash<QNetworkReply*, int> m_replyIndex;
+    QHash<QString, int> m_activePerHost;
+    int m_activeCount = 0;
+    qint64 m_nextSequence = 0;
+    QElapsedTimer m_clock;
+    QTimer *m_startTimer = nullptr;
+
+    int m_maxActive = 6;
+    int m_maxPerHost = 4;
+    int m_timeoutMs = 15000;
+    int m_maxRetries = 2;
+    int m_retryDelayMs = 500;
+};
+
+#endif // IMAGEFETCHER_H
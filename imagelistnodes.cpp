@@ -0,0 +1,419 @@
+#include "imagelistnodes.h"
+#include "titletexturecache.h"
+#include <QSGTexture>
+#include <QQuickWindow>
+#include <QtMath>
+#include <cstring>
+
+TexturedRectNode::TexturedRectNode()
+    : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLE_STRIP);
+
+    QSGGeometry::TexturedPoint2D *vertices = m_geometry.vertexDataAsTexturedPoint2D();
+    vertices[0].set(0, 0, 0.0f, 0.0f);
+    vertices[1].set(0, 0, 1.0f, 0.0f);
+    vertices[2].set(0, 0, 0.0f, 1.0f);
+    vertices[3].set(0, 0, 1.0f, 1.0f);
+
+    setGeometry(&m_geometry);
+    setMaterial(&m_material);
+}
+
+TexturedRectNode::~TexturedRectNode()
+{
+    if (m_ownsTexture) {
+        delete m_material.texture();
+    }
+}
+
+void TexturedRectNode::setRect(const QRectF &rect)
+{
+    if (m_rect == rect) {
+        return;
+    }
+    m_rect = rect;
+
+    QSGGeometry::TexturedPoint2D *vertices = m_geometry.vertexDataAsTexturedPoint2D();
+    vertices[0].x = rect.left();   vertices[0].y = rect.top();
+    vertices[1].x = rect.right();  vertices[1].y = rect.top();
+    vertices[2].x = rect.left();   vertices[2].y = rect.bottom();
+    vertices[3].x = rect.right();  vertices[3].y = rect.bottom();
+
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+void TexturedRectNode::setSourceRect(const QRectF &sourceRect)
+{
+    if (m_sourceRect == sourceRect) {
+        return;
+    }
+    m_sourceRect = sourceRect;
+
+    QSGGeometry::TexturedPoint2D *vertices = m_geometry.vertexDataAsTexturedPoint2D();
+    vertices[0].tx = sourceRect.left();   vertices[0].ty = sourceRect.top();
+    vertices[1].tx = sourceRect.right();  vertices[1].ty = sourceRect.top();
+    vertices[2].tx = sourceRect.left();   vertices[2].ty = sourceRect.bottom();
+    vertices[3].tx = sourceRect.right();  vertices[3].ty = sourceRect.bottom();
+
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+void TexturedRectNode::setTexture(QSGTexture *texture)
+{
+    QSGTexture *current = m_material.texture();
+    if (current == texture) {
+        return;
+    }
+    if (m_ownsTexture) {
+        delete current;
+    }
+    m_material.setTexture(texture);
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+QuadBatchNode::QuadBatchNode()
+    : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0, 0)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&m_geometry);
+}
+
+void QuadBatchNode::setQuads(const QVector<Quad> &quads)
+{
+    if (m_quads == quads) {
+        return;
+    }
+    m_quads = quads;
+
+    // 16-bit indices address up to 16383 quads, far more than a row holds
+    m_geometry.allocate(quads.size() * 4, quads.size() * 6);
+
+    QSGGeometry::TexturedPoint2D *vertices = m_geometry.vertexDataAsTexturedPoint2D();
+    quint16 *indices = m_geometry.indexDataAsUShort();
+
+    for (int i = 0; i < quads.size(); ++i) {
+        const QRectF &r = quads[i].rect;
+        const QRectF &s = quads[i].sourceRect;
+        QSGGeometry::TexturedPoint2D *v = vertices + i * 4;
+        v[0].set(r.left(),  r.top(),    s.left(),  s.top());
+        v[1].set(r.right(), r.top(),    s.right(), s.top());
+        v[2].set(r.left(),  r.bottom(), s.left(),  s.bottom());
+        v[3].set(r.right(), r.bottom(), s.right(), s.bottom());
+
+        quint16 base = quint16(i * 4);
+        quint16 *idx = indices + i * 6;
+        idx[0] = base;     idx[1] = base + 1; idx[2] = base + 2;
+        idx[3] = base + 2; idx[4] = base + 1; idx[5] = base + 3;
+    }
+
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+MergedPosterNode::MergedPosterNode()
+{
+    setMaterial(&m_material);
+}
+
+void MergedPosterNode::setTexture(QSGTexture *texture)
+{
+    if (m_material.texture() == texture) {
+        return;
+    }
+    m_material.setTexture(texture);
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+GlyphTextNode::GlyphTextNode(QSGTexture::Filtering filtering)
+{
+    m_material.setFiltering(filtering);
+    m_material.setFlag(QSGMaterial::Blending);
+    setMaterial(&m_material);
+}
+
+void GlyphTextNode::setTexture(QSGTexture *texture)
+{
+    if (m_material.texture() == texture) {
+        return;
+    }
+    m_material.setTexture(texture);
+    markDirty(QSGNode::DirtyMaterial);
+}
+
+DecorationNode::DecorationNode()
+    : m_geometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0, 0)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&m_geometry);
+    setMaterial(&m_material);
+}
+
+void DecorationNode::clear()
+{
+    m_pendingVertices.clear();
+    m_pendingIndices.clear();
+}
+
+static QSGGeometry::ColoredPoint2D coloredPoint(const QPointF &pos, const QColor &color)
+{
+    // The vertex colour material expects premultiplied colours
+    int a = color.alpha();
+    QSGGeometry::ColoredPoint2D point;
+    point.set(pos.x(), pos.y(), uchar(color.red() * a / 255), uchar(color.green() * a / 255),
+              uchar(color.blue() * a / 255), uchar(a));
+    return point;
+}
+
+void DecorationNode::addRect(const QRectF &rect, const QColor &color)
+{
+    quint16 base = quint16(m_pendingVertices.size());
+    m_pendingVertices << coloredPoint(rect.topLeft(), color)
+                      << coloredPoint(rect.topRight(), color)
+                      << coloredPoint(rect.bottomLeft(), color)
+                      << coloredPoint(rect.bottomRight(), color);
+    m_pendingIndices << base << quint16(base + 1) << quint16(base + 2)
+                     << quint16(base + 2) << quint16(base + 1) << quint16(base + 3);
+}
+
+void DecorationNode::addFrame(const QRectF &rect, qreal strokeWidth, qreal radius, const QColor &color)
+{
+    if (strokeWidth <= 0 || rect.isEmpty()) {
+        return;
+    }
+
+    qreal half = strokeWidth / 2;
+    QRectF outer = rect.adjusted(-half, -half, half, half);
+    QRectF inner = rect.adjusted(half, half, -half, -half);
+    if (inner.width() < 0 || inner.height() < 0) {
+        addRect(outer, color);
+        return;
+    }
+
+    qreal outerRadius = qBound<qreal>(0, radius + half, qMin(outer.width(), outer.height()) / 2);
+    qreal innerRadius = qMax<qreal>(0, outerRadius - strokeWidth);
+    int segments = outerRadius > 0 ? qBound(2, qCeil(outerRadius / 2), 8) : 0;
+
+    // Corner arcs clockwise from the top-left, sampled on both edges of the
+    // stroke; consecutive outer/inner pairs form the band's quads
+    const qreal startAngles[4] = { M_PI, 1.5 * M_PI, 0, 0.5 * M_PI };
+    const QPointF outerCenters[4] = {
+        QPointF(outer.left() + outerRadius, outer.top() + outerRadius),
+        QPointF(outer.right() - outerRadius, outer.top() + outerRadius),
+        QPointF(outer.right() - outerRadius, outer.bottom() - outerRadius),
+        QPointF(outer.left() + outerRadius, outer.bottom() - outerRadius)
+    };
+    const QPointF innerCenters[4] = {
+        QPointF(inner.left() + innerRadius, inner.top() + innerRadius),
+        QPointF(inner.right() - innerRadius, inner.top() + innerRadius),
+        QPointF(inner.right() - innerRadius, inner.bottom() - innerRadius),
+        QPointF(inner.left() + innerRadius, inner.bottom() - innerRadius)
+    };
+
+    quint16 base = quint16(m_pendingVertices.size());
+    int pairs = 0;
+    for (int corner = 0; corner < 4; ++corner) {
+        for (int step = 0; step <= segments; ++step) {
+            qreal angle = startAngles[corner] + (segments ? 0.5 * M_PI * step / segments : 0);
+            QPointF dir(qCos(angle), qSin(angle));
+            m_pendingVertices << coloredPoint(outerCenters[corner] + dir * outerRadius, color)
+                              << coloredPoint(innerCenters[corner] + dir * innerRadius, color);
+            ++pairs;
+        }
+    }
+
+    for (int i = 0; i < pairs; ++i) {
+        quint16 o0 = quint16(base + i * 2);
+        quint16 i0 = quint16(o0 + 1);
+        quint16 o1 = quint16(base + ((i + 1) % pairs) * 2);
+        quint16 i1 = quint16(o1 + 1);
+        m_pendingIndices << o0 << o1 << i0 << i0 << o1 << i1;
+    }
+}
+
+void DecorationNode::commit()
+{
+    bool same = m_pendingVertices.size() == m_vertices.size()
+        && m_pendingIndices == m_indices
+        && memcmp(m_pendingVertices.constData(), m_vertices.constData(),
+                  m_vertices.size() * sizeof(QSGGeometry::ColoredPoint2D)) == 0;
+    if (same) {
+        return;
+    }
+
+    m_vertices = m_pendingVertices;
+    m_indices = m_pendingIndices;
+
+    m_geometry.allocate(m_vertices.size(), m_indices.size());
+    memcpy(m_geometry.vertexDataAsColoredPoint2D(), m_vertices.constData(),
+           m_vertices.size() * sizeof(QSGGeometry::ColoredPoint2D));
+    memcpy(m_geometry.indexDataAsUShort(), m_indices.constData(),
+           m_indices.size() * sizeof(quint16));
+
+    markDirty(QSGNode::DirtyGeometry);
+}
+
+FocusNode::FocusNode()
+    : decorationNode(new DecorationNode)
+{
+    appendChildNode(decorationNode);
+}
+
+void FocusNode::setTarget(int index, const QRectF &rect, qreal zoom, int durationMs, QQuickWindow *window)
+{
+    m_window = window;
+    m_targetZoom = zoom;
+    m_durationMs = durationMs;
+
+    if (index != m_index) {
+        m_index = index;
+        if (m_durationMs > 0) {
+            // Restart the zoom-in; preprocess() drives it from here
+            m_animationClock.start();
+            setFlag(QSGNode::UsePreprocess, true);
+            applyZoom(1.0);
+        }
+    }
+
+    if (rect != m_rect) {
+        m_rect = rect;
+        if (m_imageNode) {
+            m_imageNode->setRect(rect);
+        }
+        // The zoom matrix is centered on the poster
+        applyZoom(m_zoom);
+    }
+
+    if (!(flags() & QSGNode::UsePreprocess)) {
+        applyZoom(m_targetZoom);
+    }
+}
+
+void FocusNode::setImage(QSGTexture *texture, const QRectF &sourceRect)
+{
+    if (!texture) {
+        if (m_imageNode) {
+            removeChildNode(m_imageNode);
+            delete m_imageNode;
+            m_imageNode = nullptr;
+        }
+        return;
+    }
+
+    if (!m_imageNode) {
+        m_imageNode = new TexturedRectNode;
+        m_imageNode->setRect(m_rect);
+        prependChildNode(m_imageNode);
+    }
+    m_imageNode->setSourceRect(sourceRect);
+    m_imageNode->setTexture(texture);
+}
+
+void FocusNode::preprocess()
+{
+    qreal progress = m_durationMs > 0
+        ? qMin<qreal>(1.0, qreal(m_animationClock.elapsed()) / m_durationMs)
+        : 1.0;
+
+    // Ease out: fast start, gentle settle
+    qreal eased = 1.0 - (1.0 - progress) * (1.0 - progress);
+    applyZoom(1.0 + (m_targetZoom - 1.0) * eased);
+
+    if (progress < 1.0) {
+        // Keep frames coming without involving the GUI thread
+        if (m_window) {
+            m_window->update();
+        }
+    } else {
+        setFlag(QSGNode::UsePreprocess, false);
+    }
+}
+
+void FocusNode::applyZoom(qreal zoom)
+{
+    m_zoom = zoom;
+
+    QPointF center = m_rect.center();
+    QMatrix4x4 m;
+    m.translate(center.x(), center.y());
+    m.scale(zoom, zoom);
+    m.translate(-center.x(), -center.y());
+
+    if (m != matrix()) {
+        setMatrix(m);
+    }
+}
+
+CategoryRowNode::CategoryRowNode()
+    : contentNode(new QSGTransformNode)
+    , focusLayer(new QSGTransformNode)
+{
+    appendChildNode(contentNode);
+    appendChildNode(focusLayer);
+}
+
+CategoryRowNode::~CategoryRowNode()
+{
+    setTitleTexture(QSharedPointer<TitleTextureCache>(), nullptr);
+}
+
+void CategoryRowNode::setTitleTexture(const QSharedPointer<TitleTextureCache> &cache, QSGTexture *texture)
+{
+    if (m_titleCache && m_titleTexture) {
+        m_titleCache->release(m_titleTexture);
+    }
+    m_titleCache = cache;
+    m_titleTexture = texture;
+}
+
+void CategoryRowNode::setRowY(qreal y)
+{
+    if (m_rowY == y) {
+        return;
+    }
+    m_rowY = y;
+
+    QMatrix4x4 m;
+    m.translate(0, y);
+    setMatrix(m);
+}
+
+void CategoryRowNode::setContentX(qreal x)
+{
+    if (m_contentX == x) {
+        return;
+    }
+    m_contentX = x;
+
+    QMatrix4x4 m;
+    m.translate(-x, 0);
+    contentNode->setMatrix(m);
+    focusLayer->setMatrix(m);
+}
+
+ImageListRootNode::~ImageListRootNode()
+{
+    // A focus node that sits in a row goes down with that row
+    if (focusNode && !focusNode->parent()) {
+        delete focusNode;
+    }
+}
+
+void ImageListRootNode::deleteRow(int categoryIndex)
+{
+    CategoryRowNode *row = rows.take(categoryIndex);
+    if (!row) {
+        return;
+    }
+    if (focusNode && focusNode->parent() == row->focusLayer) {
+        row->focusLayer->removeChildNode(focusNode);
+    }
+    removeChildNode(row);
+    delete row;
+}
+
+void ImageListRootNode::detachFocus()
+{
+    if (focusNode && focusNode->parent()) {
+        focusNode->parent()->removeChildNode(focusNode);
+    }
+}
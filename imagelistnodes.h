@@ -0,0 +1,262 @@
+#ifndef IMAGELISTNODES_H
+#define IMAGELISTNODES_H
+
+#include <QSGGeometryNode>
+#include <QSGOpaqueTextureMaterial>
+#include <QSGTextureMaterial>
+#include <QSGVertexColorMaterial>
+#include <QSGTransformNode>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QString>
+#include <QRectF>
+#include <QVector>
+#include <QSharedPointer>
+
+class QSGTexture;
+class QQuickWindow;
+class TitleTextureCache;
+
+// Retained scene graph nodes used by CustomImageListView.
+//
+// The node tree is built once and then patched in place on each
+// updatePaintNode(): a node only marks geometry or material dirty when the
+// value it is given actually differs from what it already holds.
+
+// Textured quad whose geometry and material live inside the node, so moving
+// it or swapping its texture never allocates.
+class TexturedRectNode : public QSGGeometryNode
+{
+public:
+    TexturedRectNode();
+    ~TexturedRectNode();
+
+    void setRect(const QRectF &rect);
+    QRectF rect() const { return m_rect; }
+
+    void setTexture(QSGTexture *texture);
+    QSGTexture *texture() const { return m_material.texture(); }
+
+    // Normalized texture coordinates to sample, e.g. a poster's atlas region
+    void setSourceRect(const QRectF &sourceRect);
+    QRectF sourceRect() const { return m_sourceRect; }
+
+    // When set, the node deletes its texture on destruction or replacement
+    void setOwnsTexture(bool owns) { m_ownsTexture = owns; }
+    bool ownsTexture() const { return m_ownsTexture; }
+
+private:
+    QSGGeometry m_geometry;
+    QSGOpaqueTextureMaterial m_material;
+    QRectF m_rect;
+    QRectF m_sourceRect = QRectF(0, 0, 1, 1);
+    bool m_ownsTexture = false;
+};
+
+// Textured quads sharing one texture, drawn as a single indexed triangle
+// list. Subclasses provide the material.
+class QuadBatchNode : public QSGGeometryNode
+{
+public:
+    struct Quad {
+        QRectF rect;
+        QRectF sourceRect;
+
+        bool operator==(const Quad &other) const
+        { return rect == other.rect && sourceRect == other.sourceRect; }
+        bool operator!=(const Quad &other) const { return !(*this == other); }
+    };
+
+    // Rewrites the geometry only when the quads differ from the current ones
+    void setQuads(const QVector<Quad> &quads);
+    int quadCount() const { return m_quads.size(); }
+
+protected:
+    QuadBatchNode();
+
+private:
+    QSGGeometry m_geometry;
+    QVector<Quad> m_quads;
+};
+
+// All posters of a row that sample the same texture (usually one atlas page),
+// drawn with one opaque material. Per-poster state such as the focus zoom is
+// baked into the vertex positions.
+class MergedPosterNode : public QuadBatchNode
+{
+public:
+    MergedPosterNode();
+
+    void setTexture(QSGTexture *texture);
+    QSGTexture *texture() const { return m_material.texture(); }
+
+private:
+    QSGOpaqueTextureMaterial m_material;
+};
+
+// Label glyphs of a row that live on the same glyph atlas page. Glyphs are
+// pre-coloured and premultiplied, so the material only has to blend. Text
+// drawn 1:1 samples Nearest; text under a scaling transform, such as the
+// focus zoom, needs Linear, which the glyphs' transparent border keeps clean.
+class GlyphTextNode : public QuadBatchNode
+{
+public:
+    explicit GlyphTextNode(QSGTexture::Filtering filtering = QSGTexture::Nearest);
+
+    void setTexture(QSGTexture *texture);
+    QSGTexture *texture() const { return m_material.texture(); }
+
+private:
+    QSGTextureMaterial m_material;
+};
+
+// Flat-coloured decorations such as label backgrounds, the focus frame,
+// progress bars or badges, as one vertex-coloured triangle list. The vertex
+// colour material carries no per-node state, so every decoration node in the
+// view can go into the same batch.
+//
+// Shapes are collected between clear() and commit(); the geometry is only
+// rewritten when the result differs from what the node already holds.
+class DecorationNode : public QSGGeometryNode
+{
+public:
+    DecorationNode();
+
+    void clear();
+    void addRect(const QRectF &rect, const QColor &color);
+
+    // Stroke centered on rect's outline, built from triangles so it does not
+    // depend on GL line width support
+    void addFrame(const QRectF &rect, qreal strokeWidth, qreal radius, const QColor &color);
+
+    void commit();
+    bool isEmpty() const { return m_indices.isEmpty(); }
+
+private:
+    QSGGeometry m_geometry;
+    QSGVertexColorMaterial m_material;
+    QVector<QSGGeometry::ColoredPoint2D> m_vertices;
+    QVector<quint16> m_indices;
+    QVector<QSGGeometry::ColoredPoint2D> m_pendingVertices;
+    QVector<quint16> m_pendingIndices;
+};
+
+// One poster slot holding the image quad
+class PosterItemNode : public QSGNode
+{
+public:
+    TexturedRectNode *imageNode = nullptr;
+};
+
+// The single focus highlight of the view: a zoomed copy of the focused poster
+// (and its label) with the focus frame, drawn over the unscaled row content.
+//
+// The node is created once and only re-parented into the focused row's focus
+// layer or moved to another poster rect, so a focus change leaves the rows'
+// geometry untouched. The zoom is a matrix around the poster center; with an
+// animation duration set it is eased in from preprocess() on the render thread.
+class FocusNode : public QSGTransformNode
+{
+public:
+    FocusNode();
+
+    // Moves the highlight to the poster at index, restarting the zoom-in when
+    // the index changes
+    void setTarget(int index, const QRectF &rect, qreal zoom, int durationMs, QQuickWindow *window);
+    int index() const { return m_index; }
+    QRectF rect() const { return m_rect; }
+
+    void setImage(QSGTexture *texture, const QRectF &sourceRect);
+
+    void preprocess() override;
+
+    qreal zoom() const { return m_targetZoom; }
+
+    // Focus frame and label background, with the label glyphs above them
+    DecorationNode *decorationNode = nullptr;
+    QHash<QSGTexture*, GlyphTextNode*> labelTextNodes;
+
+private:
+    void applyZoom(qreal zoom);
+
+    TexturedRectNode *m_imageNode = nullptr;
+    int m_index = -1;
+    QRectF m_rect;
+    qreal m_zoom = 1.0;
+    qreal m_targetZoom = 1.0;
+    int m_durationMs = 0;
+    QElapsedTimer m_animationClock;
+    QQuickWindow *m_window = nullptr;
+};
+
+// One category row: its title and the poster slots keyed by item index.
+//
+// The row itself is translated to its vertical position. Under it, drawn in
+// this order, are the title, contentNode with the posters and their labels,
+// and focusLayer with the FocusNode while the focused poster is in this row.
+// contentNode and focusLayer carry the same horizontal scroll offset. Both
+// scroll directions therefore only change a matrix; the poster geometry is
+// laid out once in row-local coordinates and left alone.
+class CategoryRowNode : public QSGTransformNode
+{
+public:
+    CategoryRowNode();
+    ~CategoryRowNode();
+
+    void setRowY(qreal y);
+    void setContentX(qreal x);
+
+    QSGTransformNode *contentNode = nullptr;
+
+    // Scrolls with contentNode but draws after it; holds the FocusNode while
+    // the focused poster is in this row
+    QSGTransformNode *focusLayer = nullptr;
+
+    // The title texture is borrowed from the shared cache; the row keeps the
+    // cache alive and returns its reference when it goes away
+    void setTitleTexture(const QSharedPointer<TitleTextureCache> &cache, QSGTexture *texture);
+    TexturedRectNode *titleNode = nullptr;
+    QString titleText;
+    QRectF titleRect;
+    QHash<int, PosterItemNode*> items;
+
+    // Columns the posters and labels were last laid out for
+    int firstColumn = 0;
+    int lastColumn = -1;
+
+    // Merged row mode: one node per texture instead of one slot per poster;
+    // items stays empty and the focused poster is drawn by the FocusNode
+    QHash<QSGTexture*, MergedPosterNode*> mergedNodes;
+
+    // Poster label overlays, batched per row: one decoration node for the
+    // backgrounds and one text node per glyph atlas page
+    DecorationNode *labelBackgroundNode = nullptr;
+    QHash<QSGTexture*, GlyphTextNode*> labelTextNodes;
+
+private:
+    qreal m_rowY = 0;
+    qreal m_contentX = 0;
+    QSharedPointer<TitleTextureCache> m_titleCache;
+    QSGTexture *m_titleTexture = nullptr;
+};
+
+// Root of the view's subtree, keeps direct pointers to the rows (keyed by
+// category index) so the tree can be patched without walking it. Only rows
+// that intersect the viewport are present.
+class ImageListRootNode : public QSGNode
+{
+public:
+    ~ImageListRootNode();
+
+    // Removes and deletes a row, first taking the focus node out of it
+    void deleteRow(int categoryIndex);
+
+    // Detaches the focus node from whatever row holds it
+    void detachFocus();
+
+    QHash<int, CategoryRowNode*> rows;
+    FocusNode *focusNode = nullptr;  // Lazily created, parented to a row when visible
+    bool mergedRows = false;  // Row mode the rows were built in
+};
+
+#endif // IMAGELISTNODES_H
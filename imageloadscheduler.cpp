@@ -0,0 +1,89 @@
+#include "imageloadscheduler.h"
+#include <QTimer>
+#include <QVector>
+#include <QPair>
+#include <algorithm>
+
+ImageLoadScheduler::ImageLoadScheduler(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void ImageLoadScheduler::setMaxActive(int count)
+{
+    count = qMax(1, count);
+    if (m_maxActive != count) {
+        m_maxActive = count;
+        scheduleDispatch();
+    }
+}
+
+void ImageLoadScheduler::schedule(int index, qreal priority)
+{
+    if (m_active.contains(index)) {
+        return;
+    }
+    m_queued.insert(index, priority);
+    scheduleDispatch();
+}
+
+void ImageLoadScheduler::cancel(int index)
+{
+    if (m_queued.remove(index)) {
+        return;
+    }
+    if (m_active.remove(index)) {
+        emit loadCancelled(index);
+        scheduleDispatch();
+    }
+}
+
+void ImageLoadScheduler::finish(int index)
+{
+    if (m_active.remove(index)) {
+        scheduleDispatch();
+    }
+}
+
+void ImageLoadScheduler::clear()
+{
+    m_queued.clear();
+    m_active.clear();
+}
+
+void ImageLoadScheduler::scheduleDispatch()
+{
+    if (!m_dispatchScheduled && !m_queued.isEmpty()) {
+        m_dispatchScheduled = true;
+        QTimer::singleShot(0, this, SLOT(dispatch()));
+    }
+}
+
+void ImageLoadScheduler::dispatch()
+{
+    m_dispatchScheduled = false;
+
+    int freeSlots = m_maxActive - m_active.size();
+    if (freeSlots <= 0 || m_queued.isEmpty()) {
+        return;
+    }
+
+    // Order once per pass; the queue is at most a few hundred posters
+    QVector<QPair<qreal, int> > order;
+    order.reserve(m_queued.size());
+    for (auto it = m_queued.constBegin(); it != m_queued.constEnd(); ++it) {
+        order.append(qMakePair(it.value(), it.key()));
+    }
+    std::sort(order.begin(), order.end());
+
+    for (int i = 0; i < order.size() && freeSlots > 0; ++i) {
+        int index = order[i].second;
+        m_queued.remove(index);
+        m_active.insert(index);
+        --freeSlots;
+
+        // The view may finish synchronously (e.g. from the memory cache),
+        // which only reschedules this slot
+        emit loadRequested(index);
+    }
+}
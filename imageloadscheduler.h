@@ -0,0 +1,60 @@
+#ifndef IMAGELOADSCHEDULER_H
+#define IMAGELOADSCHEDULER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+
+// Decides which poster loads run and in what order.
+//
+// The view describes the work it wants with schedule(index, priority), where
+// a lower priority value runs sooner, and calls it again whenever scrolling
+// or focus movement changes the ordering. At most maxActive loads run at a
+// time; loadRequested() starts the most urgent queued one whenever a slot is
+// free, and the view reports completion with finish().
+//
+// cancel() withdraws an item: a queued one is simply forgotten, an active one
+// frees its slot and is announced through loadCancelled() so the view can
+// abort the request or drop the decode.
+//
+// Dispatching is deferred to the event loop, so a burst of schedule() calls
+// from one scroll step is ordered once.
+class ImageLoadScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageLoadScheduler(QObject *parent = nullptr);
+
+    void setMaxActive(int count);
+    int maxActive() const { return m_maxActive; }
+
+    // Queues index, or updates its priority if it is already queued. Active
+    // items are left alone.
+    void schedule(int index, qreal priority);
+    void cancel(int index);
+    void finish(int index);
+    void clear();
+
+    bool isQueued(int index) const { return m_queued.contains(index); }
+    bool isActive(int index) const { return m_active.contains(index); }
+    QList<int> queuedIndices() const { return m_queued.keys(); }
+    QList<int> activeIndices() const { return m_active.toList(); }
+
+signals:
+    void loadRequested(int index);
+    void loadCancelled(int index);
+
+private slots:
+    void dispatch();
+
+private:
+    void scheduleDispatch();
+
+    QHash<int, qreal> m_queued;
+    QSet<int> m_active;
+    int m_maxActive = 6;
+    bool m_dispatchScheduled = false;
+};
+
+#endif // IMAGELOADSCHEDULER_H
@@ -0,0 +1,60 @@
+#include "imagememorycache.h"
+#include <climits>
+
+namespace {
+
+int costOf(const QImage &image)
+{
+    return qMax(1, int((qint64(image.byteCount()) + 1023) / 1024));
+}
+
+} // namespace
+
+ImageMemoryCache::ImageMemoryCache(qint64 maxBytes)
+{
+    setMaxBytes(maxBytes);
+}
+
+QImage ImageMemoryCache::find(const QString &key)
+{
+    QImage *image = m_cache.object(key);
+    if (!image) {
+        ++m_misses;
+        return QImage();
+    }
+    ++m_hits;
+    return *image;
+}
+
+void ImageMemoryCache::insert(const QString &key, const QImage &image)
+{
+    if (image.isNull()) {
+        return;
+    }
+
+    // QCache evicts silently, so evictions are derived from the entry count
+    int expected = m_cache.count() + (m_cache.contains(key) ? 0 : 1);
+    if (!m_cache.insert(key, new QImage(image), costOf(image))) {
+        return;  // Larger than the whole budget; QCache already dropped it
+    }
+    m_evictions += quint64(qMax(0, expected - m_cache.count()));
+}
+
+void ImageMemoryCache::clear()
+{
+    m_cache.clear();
+}
+
+void ImageMemoryCache::setMaxBytes(qint64 bytes)
+{
+    int before = m_cache.count();
+    m_cache.setMaxCost(int(qBound<qint64>(0, bytes / 1024, INT_MAX)));
+    m_evictions += quint64(qMax(0, before - m_cache.count()));
+}
+
+void ImageMemoryCache::resetStats()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
@@ -0,0 +1,50 @@
+#ifndef IMAGEMEMORYCACHE_H
+#define IMAGEMEMORYCACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QString>
+
+// Decoded images kept in memory, bounded by a byte budget.
+//
+// Images are stored as they are uploaded, already scaled and converted, so
+// the key has to identify all of that (the view uses its poster key: URL,
+// slot size and format). The same URL in a row with a larger slot or another
+// format is a different entry, never a blurry or banded copy of this one.
+// There is no mode keeping the original: the decoder reads images straight
+// at poster size, so an original would cost a second full-size decode and
+// bring back the multi-megabyte entries this cache is bounded against.
+//
+// Lookups refresh an entry; inserting past the budget evicts the least
+// recently used images first. Images are charged by their pixel data in
+// whole KiB. Hit, miss and eviction counts are kept for diagnostics.
+//
+// GUI thread only.
+class ImageMemoryCache
+{
+public:
+    explicit ImageMemoryCache(qint64 maxBytes = 32 * 1024 * 1024);
+
+    // Returns a null image on a miss
+    QImage find(const QString &key);
+    void insert(const QString &key, const QImage &image);
+    void clear();
+
+    void setMaxBytes(qint64 bytes);
+    qint64 maxBytes() const { return qint64(m_cache.maxCost()) * 1024; }
+    qint64 totalBytes() const { return qint64(m_cache.totalCost()) * 1024; }
+    int count() const { return m_cache.count(); }
+
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+    quint64 evictions() const { return m_evictions; }
+    void resetStats();
+
+private:
+    QCache<QString, QImage> m_cache;  // Cost in KiB
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+    quint64 m_evictions = 0;
+};
+
+#endif // IMAGEMEMORYCACHE_H
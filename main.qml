@@ -130,6 +130,8 @@ Window {
             focus: true
             clip: true
             startPositionX: 50
+            mergedRows: true
+            focusAnimationDuration: 120
 
 
             // Only handle specific keys, let others propagate
@@ -144,6 +146,12 @@ Window {
                 } else if (event.key === Qt.Key_T) {
                     enableTextureMetrics = !enableTextureMetrics
                     event.accepted = true
+                } else if (event.key === Qt.Key_R) {
+                    mergedRows = !mergedRows
+                    event.accepted = true
+                } else if (event.key === Qt.Key_L) {
+                    showPosterTitles = !showPosterTitles
+                    event.accepted = true
                 }
                 // Don't accept other keys, let them propagate
             }
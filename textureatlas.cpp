@@ -0,0 +1,336 @@
+#include "textureatlas.h"
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QMutexLocker>
+#include <limits>
+
+AtlasAllocator::AtlasAllocator(const QSize &size)
+    : m_size(size)
+{
+    if (!size.isEmpty()) {
+        m_freeRects.append(QRect(QPoint(0, 0), size));
+    }
+}
+
+QRect AtlasAllocator::allocate(const QSize &size)
+{
+    int bestIndex = -1;
+    int bestShortSide = std::numeric_limits<int>::max();
+    int bestLongSide = std::numeric_limits<int>::max();
+
+    // Best short side fit: the free rect that leaves the smallest sliver
+    for (int i = 0; i < m_freeRects.size(); ++i) {
+        const QRect &free = m_freeRects[i];
+        if (free.width() < size.width() || free.height() < size.height()) {
+            continue;
+        }
+
+        int leftoverX = free.width() - size.width();
+        int leftoverY = free.height() - size.height();
+        int shortSide = qMin(leftoverX, leftoverY);
+        int longSide = qMax(leftoverX, leftoverY);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestIndex = i;
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+
+    if (bestIndex < 0) {
+        return QRect();
+    }
+
+    QRect free = m_freeRects.takeAt(bestIndex);
+    QRect allocated(free.topLeft(), size);
+
+    // Split the remainder along the shorter leftover axis
+    QRect right;
+    QRect bottom;
+    if (free.width() - size.width() < free.height() - size.height()) {
+        right = QRect(free.x() + size.width(), free.y(), free.width() - size.width(), size.height());
+        bottom = QRect(free.x(), free.y() + size.height(), free.width(), free.height() - size.height());
+    } else {
+        right = QRect(free.x() + size.width(), free.y(), free.width() - size.width(), free.height());
+        bottom = QRect(free.x(), free.y() + size.height(), size.width(), free.height() - size.height());
+    }
+
+    if (!right.isEmpty()) {
+        m_freeRects.append(right);
+    }
+    if (!bottom.isEmpty()) {
+        m_freeRects.append(bottom);
+    }
+
+    return allocated;
+}
+
+bool AtlasAllocator::canAllocate(const QSize &size) const
+{
+    for (const QRect &free : m_freeRects) {
+        if (free.width() >= size.width() && free.height() >= size.height()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AtlasAllocator::release(const QRect &rect)
+{
+    if (rect.isEmpty()) {
+        return;
+    }
+    m_freeRects.append(rect);
+    mergeFreeRects();
+}
+
+bool AtlasAllocator::isEmpty() const
+{
+    qint64 freeArea = 0;
+    for (const QRect &rect : m_freeRects) {
+        freeArea += qint64(rect.width()) * rect.height();
+    }
+    return freeArea == qint64(m_size.width()) * m_size.height();
+}
+
+void AtlasAllocator::mergeFreeRects()
+{
+    // Merge pairs sharing a full edge until nothing changes
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < m_freeRects.size() && !merged; ++i) {
+            for (int j = i + 1; j < m_freeRects.size(); ++j) {
+                const QRect &a = m_freeRects[i];
+                const QRect &b = m_freeRects[j];
+
+                bool sideBySide = a.top() == b.top() && a.height() == b.height()
+                        && (a.right() + 1 == b.left() || b.right() + 1 == a.left());
+                bool stacked = a.left() == b.left() && a.width() == b.width()
+                        && (a.bottom() + 1 == b.top() || b.bottom() + 1 == a.top());
+
+                if (sideBySide || stacked) {
+                    m_freeRects[i] = a.united(b);
+                    m_freeRects.removeAt(j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+AtlasPageTexture::AtlasPageTexture(const QSize &size, QImage::Format format)
+    : m_size(size)
+    , m_format(format)
+{
+}
+
+AtlasPageTexture::~AtlasPageTexture()
+{
+    // Only possible with the render thread's context current; otherwise the GL
+    // texture went away with the context
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (m_textureId && context) {
+        GLuint id = m_textureId;
+        context->functions()->glDeleteTextures(1, &id);
+    }
+}
+
+void AtlasPageTexture::bind()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context) {
+        return;
+    }
+    QOpenGLFunctions *gl = context->functions();
+
+    bool created = false;
+    if (!m_textureId) {
+        GLuint id = 0;
+        gl->glGenTextures(1, &id);
+        m_textureId = id;
+        gl->glBindTexture(GL_TEXTURE_2D, m_textureId);
+        GLenum glFormat = m_format == QImage::Format_RGBA8888_Premultiplied ? GL_RGBA : GL_RGB;
+        gl->glTexImage2D(GL_TEXTURE_2D, 0, glFormat, m_size.width(), m_size.height(), 0,
+                         glFormat, pixelType(), nullptr);
+        created = true;
+    } else {
+        gl->glBindTexture(GL_TEXTURE_2D, m_textureId);
+    }
+
+    uploadPending(gl);
+    updateBindOptions(created);
+}
+
+void AtlasPageTexture::queueUpload(const QPoint &pos, const QImage &image)
+{
+    QMutexLocker locker(&m_uploadMutex);
+    PendingUpload upload;
+    upload.pos = pos;
+    upload.image = image;
+    m_pendingUploads.append(upload);
+}
+
+bool AtlasPageTexture::hasPendingUploads() const
+{
+    QMutexLocker locker(&m_uploadMutex);
+    return !m_pendingUploads.isEmpty();
+}
+
+void AtlasPageTexture::uploadPending(QOpenGLFunctions *gl)
+{
+    QVector<PendingUpload> uploads;
+    {
+        QMutexLocker locker(&m_uploadMutex);
+        uploads.swap(m_pendingUploads);
+    }
+
+    GLenum glFormat = m_format == QImage::Format_RGBA8888_Premultiplied ? GL_RGBA : GL_RGB;
+    for (const PendingUpload &upload : uploads) {
+        gl->glTexSubImage2D(GL_TEXTURE_2D, 0, upload.pos.x(), upload.pos.y(),
+                            upload.image.width(), upload.image.height(),
+                            glFormat, pixelType(), upload.image.constBits());
+    }
+}
+
+QRectF AtlasRegion::normalizedRect() const
+{
+    if (!page) {
+        return QRectF(0, 0, 1, 1);
+    }
+
+    QSize pageSize = page->textureSize();
+    return QRectF((rect.x() + 0.5) / pageSize.width(),
+                  (rect.y() + 0.5) / pageSize.height(),
+                  (rect.width() - 1.0) / pageSize.width(),
+                  (rect.height() - 1.0) / pageSize.height());
+}
+
+uint AtlasPageTexture::pixelType() const
+{
+    return m_format == QImage::Format_RGB16 ? GL_UNSIGNED_SHORT_5_6_5 : GL_UNSIGNED_BYTE;
+}
+
+TextureAtlas::TextureAtlas(const QSize &pageSize, QImage::Format format)
+    : m_pageSize(pageSize)
+    , m_format(isSupportedFormat(format) ? format : QImage::Format_RGBA8888_Premultiplied)
+{
+}
+
+bool TextureAtlas::isSupportedFormat(QImage::Format format)
+{
+    return format == QImage::Format_RGBA8888_Premultiplied
+        || format == QImage::Format_RGB888
+        || format == QImage::Format_RGB16;
+}
+
+int TextureAtlas::bytesPerPixel(QImage::Format format)
+{
+    switch (format) {
+    case QImage::Format_RGB888:
+        return 3;
+    case QImage::Format_RGB16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    // Pages not handed out through takePages() are freed here; without a
+    // current GL context only their CPU side can be released
+    qDeleteAll(takePages());
+}
+
+AtlasRegion TextureAtlas::insert(const QImage &image)
+{
+    AtlasRegion region;
+    if (image.isNull() || image.width() > m_pageSize.width() || image.height() > m_pageSize.height()) {
+        return region;
+    }
+
+    // Uploaded as is; premultiplied RGBA is what the scene graph expects of
+    // textures with alpha
+    QImage upload = image.format() == m_format ? image : image.convertToFormat(m_format);
+
+    for (Page *page : m_pages) {
+        QRect rect = page->allocator.allocate(upload.size());
+        if (!rect.isNull()) {
+            page->texture->queueUpload(rect.topLeft(), upload);
+            region.page = page->texture;
+            region.rect = rect;
+            return region;
+        }
+    }
+
+    Page *page = new Page{ new AtlasPageTexture(m_pageSize, m_format), AtlasAllocator(m_pageSize) };
+    m_pages.append(page);
+
+    QRect rect = page->allocator.allocate(upload.size());
+    page->texture->queueUpload(rect.topLeft(), upload);
+    region.page = page->texture;
+    region.rect = rect;
+    return region;
+}
+
+qint64 TextureAtlas::insertCost(const QSize &size) const
+{
+    if (size.width() > m_pageSize.width() || size.height() > m_pageSize.height()) {
+        return -1;
+    }
+    for (Page *page : m_pages) {
+        if (page->allocator.canAllocate(size)) {
+            return 0;
+        }
+    }
+    return qint64(m_pageSize.width()) * m_pageSize.height() * bytesPerPixel(m_format);
+}
+
+void TextureAtlas::release(const AtlasRegion &region)
+{
+    if (region.isNull()) {
+        return;
+    }
+
+    for (int i = 0; i < m_pages.size(); ++i) {
+        Page *page = m_pages[i];
+        if (page->texture == region.page) {
+            page->allocator.release(region.rect);
+            if (page->allocator.isEmpty()) {
+                m_freedPages.append(page->texture);
+                m_pages.remove(i);
+                delete page;
+            }
+            return;
+        }
+    }
+}
+
+void TextureAtlas::commitUploads()
+{
+    for (Page *page : m_pages) {
+        if (page->texture->hasPendingUploads()) {
+            page->texture->bind();
+        }
+    }
+}
+
+QList<QSGTexture*> TextureAtlas::takePages()
+{
+    QList<QSGTexture*> textures;
+    for (Page *page : m_pages) {
+        textures.append(page->texture);
+        delete page;
+    }
+    m_pages.clear();
+    textures += takeFreedPages();
+    return textures;
+}
+
+QList<QSGTexture*> TextureAtlas::takeFreedPages()
+{
+    QList<QSGTexture*> textures = m_freedPages;
+    m_freedPages.clear();
+    return textures;
+}
@@ -0,0 +1,140 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <QSGTexture>
+#include <QImage>
+#include <QMutex>
+#include <QRect>
+#include <QVector>
+#include <QList>
+
+class QOpenGLFunctions;
+
+// Free-rectangle allocator for one atlas page.
+//
+// Allocation picks the free rectangle with the best short-side fit and splits
+// the remainder guillotine style. Released rectangles go back to the free list
+// and are merged with neighbours that share a full edge, so space reclaimed on
+// eviction can be reused by posters of the same size.
+class AtlasAllocator
+{
+public:
+    explicit AtlasAllocator(const QSize &size = QSize());
+
+    QRect allocate(const QSize &size);
+    void release(const QRect &rect);
+    bool canAllocate(const QSize &size) const;
+
+    bool isEmpty() const;
+
+private:
+    void mergeFreeRects();
+
+    QSize m_size;
+    QVector<QRect> m_freeRects;
+};
+
+// One page of the atlas as a scene graph texture. Images are queued on the GUI
+// thread and copied into the GL texture with glTexSubImage2D on the render
+// thread, either from commitUploads() during the sync phase or on bind().
+//
+// The page stores one pixel layout, given as the QImage format its images
+// arrive in: premultiplied RGBA8888, or for opaque content RGB888 (GL_RGB) or
+// RGB16 (GL_RGB / GL_UNSIGNED_SHORT_5_6_5). QImage pads scanlines to 4 bytes,
+// which matches GL's default unpack alignment for all three.
+class AtlasPageTexture : public QSGTexture
+{
+public:
+    AtlasPageTexture(const QSize &size, QImage::Format format);
+    ~AtlasPageTexture();
+
+    int textureId() const override { return int(m_textureId); }
+    QSize textureSize() const override { return m_size; }
+    bool hasAlphaChannel() const override { return m_format == QImage::Format_RGBA8888_Premultiplied; }
+    bool hasMipmaps() const override { return false; }
+    void bind() override;
+
+    void queueUpload(const QPoint &pos, const QImage &image);
+    bool hasPendingUploads() const;
+
+private:
+    struct PendingUpload {
+        QPoint pos;
+        QImage image;
+    };
+
+    void uploadPending(QOpenGLFunctions *gl);
+    uint pixelType() const;  // GL type matching m_format
+
+    QSize m_size;
+    QImage::Format m_format;
+    uint m_textureId = 0;
+    QVector<PendingUpload> m_pendingUploads;
+    mutable QMutex m_uploadMutex;
+};
+
+// Location of an image inside the atlas
+struct AtlasRegion {
+    AtlasPageTexture *page = nullptr;
+    QRect rect;
+
+    bool isNull() const { return !page; }
+
+    // Texture coordinates of the region, inset by half a texel so linear
+    // filtering never samples the neighbouring image
+    QRectF normalizedRect() const;
+};
+
+// Packs poster images into a few large shared textures so that the posters of
+// a row bind the same texture and the renderer can batch them. Images are
+// converted to the atlas format on insert, if they are not in it already.
+//
+// insert() and release() are called on the GUI thread; commitUploads() must
+// be called on the render thread with the GL context current. Pages are
+// QSGTextures and have to be deleted on the render thread as well, which is
+// why the atlas hands them out through takePages() instead of deleting them.
+// A page whose last region is released leaves the atlas right away and is
+// handed out through takeFreedPages().
+class TextureAtlas
+{
+public:
+    explicit TextureAtlas(const QSize &pageSize = QSize(2048, 2048),
+                          QImage::Format format = QImage::Format_RGBA8888_Premultiplied);
+    ~TextureAtlas();
+
+    AtlasRegion insert(const QImage &image);
+    void release(const AtlasRegion &region);
+
+    // Bytes byteSize() grows by if insert() were called for an image of
+    // size: 0 if a page has room, a page if it needs a new one, and -1 if
+    // the image is larger than a page and cannot be inserted
+    qint64 insertCost(const QSize &size) const;
+
+    void commitUploads();
+
+    QList<QSGTexture*> takePages();
+    QList<QSGTexture*> takeFreedPages();
+    int pageCount() const { return m_pages.size(); }
+    QImage::Format format() const { return m_format; }
+
+    // Formats a page can store; anything else is uploaded as RGBA8888
+    static bool isSupportedFormat(QImage::Format format);
+    static int bytesPerPixel(QImage::Format format);
+
+    // GPU memory of the pages currently in the atlas
+    qint64 byteSize() const
+    { return qint64(m_pages.size()) * m_pageSize.width() * m_pageSize.height() * bytesPerPixel(m_format); }
+
+private:
+    struct Page {
+        AtlasPageTexture *texture;
+        AtlasAllocator allocator;
+    };
+
+    QSize m_pageSize;
+    QImage::Format m_format;
+    QVector<Page*> m_pages;
+    QList<QSGTexture*> m_freedPages;
+};
+
+#endif // TEXTUREATLAS_H
@@ -0,0 +1,243 @@
+#include "texturecache.h"
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QRunnable>
+#include <QDebug>
+
+namespace {
+
+// Window -> its cache, for as long as some item holds it
+QHash<QQuickWindow*, QWeakPointer<TextureCache> > &caches()
+{
+    static QHash<QQuickWindow*, QWeakPointer<TextureCache> > registry;
+    return registry;
+}
+
+class DeleteTexturesJob : public QRunnable
+{
+public:
+    explicit DeleteTexturesJob(const QList<QSGTexture*> &textures) : m_textures(textures) {}
+    void run() override { qDeleteAll(m_textures); }
+
+private:
+    QList<QSGTexture*> m_textures;
+};
+
+} // namespace
+
+QSharedPointer<TextureCache> TextureCache::forWindow(QQuickWindow *window)
+{
+    if (!window) {
+        return QSharedPointer<TextureCache>();
+    }
+
+    QSharedPointer<TextureCache> cache = caches().value(window).toStrongRef();
+    if (!cache) {
+        cache = QSharedPointer<TextureCache>(new TextureCache(window));
+        caches().insert(window, cache);
+    }
+    return cache;
+}
+
+TextureCache::TextureCache(QQuickWindow *window)
+    : m_window(window)
+    , m_windowKey(window)
+{
+}
+
+TextureCache::~TextureCache()
+{
+    // forWindow() may already have registered a successor once this cache's
+    // last reference was dropped; only an expired entry can be this one
+    auto it = caches().find(m_windowKey);
+    if (it != caches().end() && it.value().isNull()) {
+        caches().erase(it);
+    }
+
+    QList<QSGTexture*> textures = m_garbage;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        if (!it.value().atlas) {
+            textures.append(it.value().handle.texture);
+        }
+    }
+    for (TextureAtlas *atlas : m_atlases) {
+        textures += atlas->takePages();
+    }
+    qDeleteAll(m_atlases);
+
+    // GL textures go on the render thread; once the window is gone there is
+    // no context left and only the CPU side can be released
+    if (m_window) {
+        m_window->scheduleRenderJob(new DeleteTexturesJob(textures), QQuickWindow::BeforeRenderingStage);
+    } else {
+        qDeleteAll(textures);
+    }
+}
+
+bool TextureCache::insert(const QString &key, const QImage &image)
+{
+    if (m_entries.contains(key)) {
+        return true;
+    }
+    if (image.isNull()) {
+        return false;
+    }
+
+    // Images in other formats are converted to RGBA
+    const qint64 bytes = qint64(image.width()) * image.height()
+            * (TextureAtlas::isSupportedFormat(image.format()) ? TextureAtlas::bytesPerPixel(image.format()) : 4);
+
+    // The image is only placed, and its upload queued, once it fits. While
+    // it would take a new page over budget, the least recently released
+    // entry is evicted and the fit checked again, one entry at a time: pages
+    // are charged in full, so a single eviction rarely lowers the total, but
+    // the atlas space it frees may already be enough for the new image.
+    TextureAtlas *atlas = atlasFor(image.format());
+    for (;;) {
+        qint64 cost = atlas->insertCost(image.size());
+        if (totalBytes() + (cost < 0 ? bytes : cost) <= m_maxBytes) {
+            place(key, image, bytes);
+            m_unused.append(key);
+            m_unusedBytes += bytes;
+            m_peakBytes = qMax(m_peakBytes, totalBytes());
+            return true;
+        }
+
+        if (m_unused.isEmpty()) {
+            break;
+        }
+        evict(m_unused.first());
+    }
+
+    qWarning() << "TextureCache: budget of" << m_maxBytes << "bytes exceeded, refusing" << key;
+    return false;
+}
+
+// Queues image for upload and records it under key, without touching the LRU.
+// Nothing here touches GL: pages and standalone textures are created and
+// filled by commitUploads() or their first bind(), both on the render thread.
+void TextureCache::place(const QString &key, const QImage &image, qint64 bytes)
+{
+    Entry entry;
+    entry.bytes = bytes;
+    TextureAtlas *atlas = atlasFor(image.format());
+    entry.region = atlas->insert(image);
+    if (!entry.region.isNull()) {
+        entry.atlas = atlas;
+        entry.handle.texture = entry.region.page;
+        entry.handle.sourceRect = entry.region.normalizedRect();
+    } else {
+        // Too large for a page: a page-like texture of its own holding just
+        // this image
+        QImage::Format format = atlas->format();
+        AtlasPageTexture *texture = new AtlasPageTexture(image.size(), format);
+        texture->queueUpload(QPoint(0, 0), image.format() == format ? image : image.convertToFormat(format));
+        m_pendingTextures.append(texture);
+        entry.handle.texture = texture;
+        m_standaloneBytes += bytes;
+    }
+
+    m_entries.insert(key, entry);
+}
+
+TextureCache::Handle TextureCache::acquire(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return Handle();
+    }
+    if (it.value().refCount++ == 0) {
+        m_unused.removeOne(key);
+        m_unusedBytes -= it.value().bytes;
+    }
+    return it.value().handle;
+}
+
+void TextureCache::release(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it.value().refCount <= 0) {
+        return;
+    }
+    if (--it.value().refCount == 0) {
+        m_unused.append(key);
+        m_unusedBytes += it.value().bytes;
+        trimUnused(m_maxBytes);
+    }
+}
+
+qint64 TextureCache::totalBytes() const
+{
+    qint64 bytes = m_standaloneBytes;
+    for (TextureAtlas *atlas : m_atlases) {
+        bytes += atlas->byteSize();
+    }
+    return bytes;
+}
+
+// The atlas storing images of format; formats without one of their own are
+// converted to premultiplied RGBA
+TextureAtlas *TextureCache::atlasFor(QImage::Format format)
+{
+    if (!TextureAtlas::isSupportedFormat(format)) {
+        format = QImage::Format_RGBA8888_Premultiplied;
+    }
+    TextureAtlas *&atlas = m_atlases[format];
+    if (!atlas) {
+        atlas = new TextureAtlas(QSize(2048, 2048), format);
+    }
+    return atlas;
+}
+
+void TextureCache::setMaxBytes(qint64 bytes)
+{
+    m_maxBytes = qMax<qint64>(0, bytes);
+    trimUnused(m_maxBytes);
+}
+
+// Evicts unused entries, least recently released first, until the cache
+// holds at most maxBytes. Referenced entries are never evicted.
+void TextureCache::trimUnused(qint64 maxBytes)
+{
+    while (totalBytes() > maxBytes && !m_unused.isEmpty()) {
+        evict(m_unused.first());
+    }
+}
+
+void TextureCache::evict(const QString &key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    const Entry &entry = it.value();
+    if (entry.atlas) {
+        entry.atlas->release(entry.region);
+        m_garbage += entry.atlas->takeFreedPages();
+    } else {
+        m_pendingTextures.removeOne(static_cast<AtlasPageTexture*>(entry.handle.texture));
+        m_garbage.append(entry.handle.texture);
+        m_standaloneBytes -= entry.bytes;
+    }
+
+    if (entry.refCount == 0 && m_unused.removeOne(key)) {
+        m_unusedBytes -= entry.bytes;
+    }
+    m_entries.erase(it);
+}
+
+void TextureCache::commitUploads()
+{
+    for (TextureAtlas *atlas : m_atlases) {
+        atlas->commitUploads();
+    }
+
+    for (AtlasPageTexture *texture : m_pendingTextures) {
+        texture->bind();
+    }
+    m_pendingTextures.clear();
+
+    qDeleteAll(m_garbage);
+    m_garbage.clear();
+}
@@ -0,0 +1,103 @@
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QRectF>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QSharedPointer>
+#include "textureatlas.h"
+
+class QQuickWindow;
+class QSGTexture;
+
+// Content-addressed, refcounted textures of one window, shared by every item
+// drawing into it.
+//
+// Images are uploaded once under a key that identifies their pixels (e.g.
+// source URL, size and format). Small images are packed into the cache's
+// atlases so items batch; images larger than an atlas page get a texture of
+// their own. Images that arrive as RGB888 or RGB16 are opaque and go into an
+// atlas of that format, at 3 or 2 bytes per pixel instead of 4.
+// Holders take a reference with acquire() and give it back with release().
+// Entries nobody references stay resident in least-recently-released order
+// and are evicted oldest first once the resident bytes exceed maxBytes, so an
+// image scrolled back into view is usually still there.
+//
+// maxBytes is a hard ceiling on the GPU memory the cache holds: atlas pages
+// count in full from the moment they are allocated until their last image is
+// evicted, standalone textures by their own size. An insert() that cannot be
+// made to fit by evicting unused entries is refused, and the caller is left
+// to release references or show a placeholder.
+//
+// insert(), acquire() and release() run on the GUI thread and never touch
+// GL: inserted images are only queued. commitUploads() runs on the render
+// thread during the sync phase, where it creates and fills the textures and
+// deletes evicted ones. The cache itself lives as long as any item of the
+// window holds it; its remaining textures are then deleted by a render job.
+class TextureCache
+{
+public:
+    // What a reference draws: the texture and the part of it to sample
+    struct Handle {
+        QSGTexture *texture = nullptr;
+        QRectF sourceRect = QRectF(0, 0, 1, 1);
+
+        bool isNull() const { return !texture; }
+    };
+
+    static QSharedPointer<TextureCache> forWindow(QQuickWindow *window);
+    ~TextureCache();
+
+    bool contains(const QString &key) const { return m_entries.contains(key); }
+
+    // Uploads image under key, unreferenced; does nothing if key is resident.
+    // Returns false when the image does not fit the budget.
+    bool insert(const QString &key, const QImage &image);
+
+    // References a resident entry, reviving it if it was unused; returns a
+    // null handle when key is not resident
+    Handle acquire(const QString &key);
+    void release(const QString &key);
+
+    void commitUploads();
+
+    void setMaxBytes(qint64 bytes);
+    qint64 maxBytes() const { return m_maxBytes; }
+    qint64 totalBytes() const;
+    qint64 peakBytes() const { return m_peakBytes; }
+    qint64 unusedBytes() const { return m_unusedBytes; }  // Pixel bytes of unreferenced entries
+    int count() const { return m_entries.size(); }
+
+private:
+    explicit TextureCache(QQuickWindow *window);
+
+    struct Entry {
+        Handle handle;
+        TextureAtlas *atlas = nullptr;  // Null for standalone textures
+        AtlasRegion region;
+        qint64 bytes = 0;
+        int refCount = 0;
+    };
+
+    TextureAtlas *atlasFor(QImage::Format format);
+    void place(const QString &key, const QImage &image, qint64 bytes);
+    void evict(const QString &key);
+    void trimUnused(qint64 maxBytes);
+
+    QPointer<QQuickWindow> m_window;
+    QQuickWindow *m_windowKey;  // Registry key, valid after the window is gone
+    QHash<int, TextureAtlas*> m_atlases;  // By QImage::Format
+    QHash<QString, Entry> m_entries;
+    QList<QString> m_unused;  // Least recently released first
+    QList<AtlasPageTexture*> m_pendingTextures;  // Standalone textures not uploaded yet
+    QList<QSGTexture*> m_garbage;  // Evicted standalone textures and freed pages
+    qint64 m_standaloneBytes = 0;
+    qint64 m_peakBytes = 0;
+    qint64 m_unusedBytes = 0;
+    qint64 m_maxBytes = 96 * 1024 * 1024;
+};
+
+#endif // TEXTURECACHE_H
@@ -0,0 +1,280 @@
+#include "thumbnailcache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+const quint32 kMagic = 0x54475351;  // "QSGT"
+const quint32 kVersion = 1;
+const char *kSuffix = ".thumb";
+
+// Fixed-size file header; the pixels follow at a 16 byte aligned offset
+struct Header {
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+    quint32 reserved[2];
+};
+
+static_assert(sizeof(Header) == 32, "thumbnail header layout changed");
+
+// Releases the mapping when the last QImage sharing it goes away. The QFile
+// has no parent and no connections, so deleting it from the render thread is
+// fine.
+void unmapThumbnail(void *info)
+{
+    delete static_cast<QFile*>(info);
+}
+
+} // namespace
+
+ThumbnailCache::ThumbnailCache(const QString &directory)
+    : m_directory(directory)
+{
+    if (m_directory.isEmpty()) {
+        m_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                + QLatin1String("/thumbnails");
+    }
+    QDir().mkpath(m_directory);
+    scanDirectory();
+}
+
+QString ThumbnailCache::keyFor(const QUrl &url, const QSize &targetSize, QImage::Format format) const
+{
+    QByteArray id = url.toEncoded();
+    id += '@';
+    id += QByteArray::number(targetSize.width());
+    id += 'x';
+    id += QByteArray::number(targetSize.height());
+
+    // RGBA entries keep the keys they were stored under before formats
+    if (format != QImage::Format_RGBA8888_Premultiplied) {
+        id += '#';
+        id += QByteArray::number(int(format));
+    }
+    return QString::fromLatin1(QCryptographicHash::hash(id, QCryptographicHash::Sha1).toHex());
+}
+
+QString ThumbnailCache::pathFor(const QString &key) const
+{
+    return m_directory + QLatin1Char('/') + key + QLatin1String(kSuffix);
+}
+
+QImage ThumbnailCache::load(const QUrl &url, const QSize &targetSize, QImage::Format format)
+{
+    QString key = keyFor(url, targetSize, format);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_entries.contains(key)) {
+            return QImage();
+        }
+    }
+
+    QFile *file = new QFile(pathFor(key));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(Header))) {
+        delete file;
+        return QImage();
+    }
+
+    uchar *mapped = file->map(0, file->size());
+    if (!mapped) {
+        delete file;
+        return QImage();
+    }
+
+    const Header *header = reinterpret_cast<const Header*>(mapped);
+    qint64 pixelBytes = qint64(header->bytesPerLine) * header->height;
+    if (header->magic != kMagic || header->version != kVersion
+            || header->width <= 0 || header->height <= 0
+            || header->format != format
+            || file->size() < qint64(sizeof(Header)) + pixelBytes) {
+        qWarning() << "Discarding corrupt thumbnail" << file->fileName();
+        delete file;
+        removeEntry(key);
+        return QImage();
+    }
+
+    // Eviction goes by last use, so posters shown often outlive ones written
+    // later but never looked at again
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            it.value().lastUsed = QDateTime::currentMSecsSinceEpoch() / 1000;
+        }
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    // Kept across launches through the file time scanDirectory() reads
+    file->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#endif
+
+    // The image reads straight from the page cache; the file stays mapped
+    // until the atlas upload and every other copy of the image are done. The
+    // mapping is read-only, so the image gets the const data constructor and
+    // Qt copies the pixels before anything writes to them.
+    const uchar *pixels = mapped + sizeof(Header);
+    return QImage(pixels, header->width, header->height,
+                  header->bytesPerLine, QImage::Format(header->format),
+                  unmapThumbnail, file);
+}
+
+bool ThumbnailCache::store(const QUrl &url, const QSize &targetSize, const QImage &image)
+{
+    if (image.isNull() || !url.isValid()) {
+        return false;
+    }
+
+    // Opaque formats are stored as they are, anything else as RGBA
+    QImage pixels = image;
+    if (image.format() != QImage::Format_RGB888 && image.format() != QImage::Format_RGB16
+            && image.format() != QImage::Format_RGBA8888_Premultiplied) {
+        pixels = image.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+    }
+
+    Header header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.width = pixels.width();
+    header.height = pixels.height();
+    header.bytesPerLine = pixels.bytesPerLine();
+    header.format = pixels.format();
+    header.reserved[0] = header.reserved[1] = 0;
+
+    QString key = keyFor(url, targetSize, pixels.format());
+
+    // QSaveFile writes to a temporary and renames, so a reader never maps a
+    // half written entry
+    QSaveFile file(pathFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    qint64 pixelBytes = qint64(pixels.bytesPerLine()) * pixels.height();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(pixels.constBits()), pixelBytes);
+    if (!file.commit()) {
+        qWarning() << "Failed to write thumbnail" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_totalBytes -= it.value().size;
+    }
+    Entry entry;
+    entry.size = qint64(sizeof(header)) + pixelBytes;
+    entry.lastUsed = QDateTime::currentMSecsSinceEpoch() / 1000;
+    m_entries.insert(key, entry);
+    m_totalBytes += entry.size;
+
+    if (m_totalBytes > m_maxBytes) {
+        trim();
+    }
+    return true;
+}
+
+void ThumbnailCache::setMaxBytes(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxBytes = qMax<qint64>(0, bytes);
+    trim();
+}
+
+void ThumbnailCache::setMaxAgeDays(int days)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxAgeDays = qMax(0, days);
+    trim();
+}
+
+qint64 ThumbnailCache::totalBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_totalBytes;
+}
+
+void ThumbnailCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        QFile::remove(pathFor(it.key()));
+    }
+    m_entries.clear();
+    m_totalBytes = 0;
+}
+
+void ThumbnailCache::scanDirectory()
+{
+    QDir dir(m_directory);
+    QStringList filters;
+    filters << QString::fromLatin1("*") + QLatin1String(kSuffix);
+    const QFileInfoList files = dir.entryInfoList(filters, QDir::Files);
+
+    QMutexLocker locker(&m_mutex);
+    for (const QFileInfo &info : files) {
+        Entry entry;
+        entry.size = info.size();
+        entry.lastUsed = info.lastModified().toMSecsSinceEpoch() / 1000;
+        m_entries.insert(info.completeBaseName(), entry);
+        m_totalBytes += entry.size;
+    }
+    trim();
+}
+
+void ThumbnailCache::removeEntry(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_totalBytes -= it.value().size;
+        m_entries.erase(it);
+    }
+    QFile::remove(pathFor(key));
+}
+
+void ThumbnailCache::trim()
+{
+    // Entries unused for maxAge go regardless of the budget
+    qint64 now = QDateTime::currentMSecsSinceEpoch() / 1000;
+    qint64 maxAge = qint64(m_maxAgeDays) * 24 * 60 * 60;
+    QList<QPair<qint64, QString> > byAge;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        if (now - it.value().lastUsed > maxAge) {
+            QFile::remove(pathFor(it.key()));
+            m_totalBytes -= it.value().size;
+            it = m_entries.erase(it);
+        } else {
+            byAge.append(qMakePair(it.value().lastUsed, it.key()));
+            ++it;
+        }
+    }
+
+    if (m_totalBytes <= m_maxBytes) {
+        return;
+    }
+
+    // Then the least recently used, down to 90% of the budget so the next few stores do
+    // not each trigger another pass. Files that are still mapped stay readable
+    // after removal.
+    std::sort(byAge.begin(), byAge.end());
+    qint64 target = m_maxBytes - m_maxBytes / 10;
+    for (const QPair<qint64, QString> &entry : byAge) {
+        if (m_totalBytes <= target) {
+            break;
+        }
+        auto it = m_entries.find(entry.second);
+        QFile::remove(pathFor(entry.second));
+        m_totalBytes -= it.value().size;
+        m_entries.erase(it);
+    }
+}
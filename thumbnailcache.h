@@ -0,0 +1,68 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QSize>
+#include <QUrl>
+#include <QHash>
+#include <QMutex>
+
+// Persistent store of poster thumbnails that are ready to upload.
+//
+// Each entry holds the pixels exactly as the atlas uploads them (premultiplied
+// RGBA, or RGB888 / RGB16 for opaque posters, already scaled to the poster
+// slot). Entries are keyed by source URL, target size and format, so a slot
+// size or format change never yields a wrongly sized or converted image.
+// load() memory-maps the file and wraps the mapping in a QImage without
+// copying it. A cold start therefore goes from the disk straight to
+// glTexSubImage2D, with no download and no decode.
+//
+// The store is trimmed to a byte budget, least recently used entries first,
+// and entries unused for maxAge are dropped. A load() counts as use; on Qt
+// 5.10 and later it also updates the file time, so the order survives a
+// restart (before that it falls back to write time across launches).
+// load() is meant for the GUI thread; store() may be called from decoder
+// workers.
+class ThumbnailCache
+{
+public:
+    explicit ThumbnailCache(const QString &directory = QString());
+
+    QImage load(const QUrl &url, const QSize &targetSize,
+                QImage::Format format = QImage::Format_RGBA8888_Premultiplied);
+    bool store(const QUrl &url, const QSize &targetSize, const QImage &image);
+
+    void setMaxBytes(qint64 bytes);
+    qint64 maxBytes() const { return m_maxBytes; }
+
+    void setMaxAgeDays(int days);
+    int maxAgeDays() const { return m_maxAgeDays; }
+
+    qint64 totalBytes() const;
+    QString directory() const { return m_directory; }
+
+    void clear();
+
+private:
+    struct Entry {
+        qint64 size;
+        qint64 lastUsed;  // Seconds since epoch of the last store or load
+    };
+
+    QString keyFor(const QUrl &url, const QSize &targetSize, QImage::Format format) const;
+    QString pathFor(const QString &key) const;
+    void scanDirectory();
+    void removeEntry(const QString &key);
+    void trim();  // Expects m_mutex to be held
+
+    QString m_directory;
+    qint64 m_maxBytes = 256 * 1024 * 1024;
+    int m_maxAgeDays = 30;
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    qint64 m_totalBytes = 0;
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,121 @@
+#include "titletexturecache.h"
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QImage>
+#include <QPainter>
+#include <QFontMetrics>
+
+bool TitleTextureCache::Key::operator==(const Key &other) const
+{
+    return text == other.text && font == other.font
+        && color == other.color && size == other.size;
+}
+
+uint qHash(const TitleTextureCache::Key &key, uint seed)
+{
+    return qHash(key.text, seed) ^ qHash(key.font.key(), seed)
+        ^ key.color.rgba() ^ uint(key.size.width() << 16 | key.size.height());
+}
+
+TitleTextureCache::TitleTextureCache(int maxUnused)
+    : m_maxUnused(maxUnused)
+{
+}
+
+TitleTextureCache::~TitleTextureCache()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        delete it.value().texture;
+    }
+}
+
+QSGTexture *TitleTextureCache::acquire(const Key &key, QQuickWindow *window)
+{
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        if (it.value().refCount++ == 0) {
+            m_unused.removeOne(key);
+        }
+        return it.value().texture;
+    }
+
+    QSGTexture *texture = rasterize(key, window);
+    if (!texture) {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.texture = texture;
+    entry.refCount = 1;
+    m_entries.insert(key, entry);
+    m_keys.insert(texture, key);
+    return texture;
+}
+
+void TitleTextureCache::release(QSGTexture *texture)
+{
+    auto keyIt = m_keys.constFind(texture);
+    if (keyIt == m_keys.constEnd()) {
+        return;
+    }
+
+    Entry &entry = m_entries[keyIt.value()];
+    if (--entry.refCount == 0) {
+        m_unused.append(keyIt.value());
+        trimUnused();
+    }
+}
+
+QList<QSGTexture*> TitleTextureCache::takeUnused()
+{
+    QList<QSGTexture*> textures;
+    for (const Key &key : m_unused) {
+        QSGTexture *texture = m_entries.take(key).texture;
+        m_keys.remove(texture);
+        textures.append(texture);
+    }
+    m_unused.clear();
+    return textures;
+}
+
+void TitleTextureCache::trimUnused()
+{
+    while (m_unused.size() > m_maxUnused) {
+        Key key = m_unused.takeFirst();
+        QSGTexture *texture = m_entries.take(key).texture;
+        m_keys.remove(texture);
+        delete texture;
+    }
+}
+
+QSGTexture *TitleTextureCache::rasterize(const Key &key, QQuickWindow *window) const
+{
+    if (!window || key.size.isEmpty()) {
+        return nullptr;
+    }
+
+    QImage textImage(key.size, QImage::Format_ARGB32_Premultiplied);
+    if (textImage.isNull()) {
+        return nullptr;
+    }
+
+    textImage.fill(QColor(0, 0, 0, 0));
+
+    QPainter painter;
+    if (!painter.begin(&textImage)) {
+        return nullptr;
+    }
+
+    painter.setFont(key.font);
+    painter.setPen(key.color);
+    painter.setRenderHints(QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+    // Draw text with left alignment and vertical centering
+    QFontMetrics fm(key.font);
+    int yPos = (key.size.height() + fm.ascent() - fm.descent()) / 2;
+    painter.drawText(10, yPos, key.text);
+
+    painter.end();
+
+    return window->createTextureFromImage(textImage, QQuickWindow::TextureHasAlphaChannel);
+}
@@ -0,0 +1,65 @@
+#ifndef TITLETEXTURECACHE_H
+#define TITLETEXTURECACHE_H
+
+#include <QString>
+#include <QFont>
+#include <QColor>
+#include <QSize>
+#include <QHash>
+#include <QList>
+
+class QQuickWindow;
+class QSGTexture;
+
+// Rasterized row titles shared between the rows that show them.
+//
+// A title texture is identified by everything that affects its pixels (text,
+// font, color and image size) and is refcounted by the rows holding it, so a
+// frame only rasterizes text when a title actually changes. Textures whose
+// last row went away are kept in a small LRU, since culled rows come back as
+// soon as the user scrolls back.
+//
+// acquire() and release() run on the render thread (updatePaintNode or node
+// destruction), which is also where the textures have to be deleted.
+class TitleTextureCache
+{
+public:
+    struct Key {
+        QString text;
+        QFont font;
+        QColor color;
+        QSize size;
+
+        bool operator==(const Key &other) const;
+    };
+
+    explicit TitleTextureCache(int maxUnused = 32);
+    ~TitleTextureCache();
+
+    QSGTexture *acquire(const Key &key, QQuickWindow *window);
+    void release(QSGTexture *texture);
+
+    // Hands out the textures no row references, e.g. to delete them on the
+    // render thread when the view goes away
+    QList<QSGTexture*> takeUnused();
+
+    int textureCount() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        QSGTexture *texture;
+        int refCount;
+    };
+
+    QSGTexture *rasterize(const Key &key, QQuickWindow *window) const;
+    void trimUnused();
+
+    QHash<Key, Entry> m_entries;
+    QHash<QSGTexture*, Key> m_keys;
+    QList<Key> m_unused;  // Least recently released first
+    int m_maxUnused;
+};
+
+uint qHash(const TitleTextureCache::Key &key, uint seed = 0);
+
+#endif // TITLETEXTURECACHE_H